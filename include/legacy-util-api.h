@@ -36,6 +36,26 @@ extern "C" {
 /* See tmpfile(3). */
 FILE *tmpf(char *ignored);
 
+/* A scratch file that is written sequentially and then read back from the
+ * start.  It is kept in memory (see open_memstream(3)) where the host
+ * allows, and is a tmpf() file otherwise.
+ */
+typedef struct memfile {
+  FILE *file;
+  char *base;
+  size_t size;
+  int inmem;
+} MEMFILE;
+
+/* Open 'mf' for writing; returns the stream, or NULL on failure. */
+FILE *memf_open(MEMFILE *mf);
+
+/* Finish writing 'mf' and return a stream that reads it from the start. */
+FILE *memf_rewind(MEMFILE *mf);
+
+/* Close 'mf' and release its storage. */
+void memf_close(MEMFILE *mf);
+
 /* Copy to 'basename' the final path component, less any undesirable suffix. */
 void basenam(const char *orig_path, const char *optional_suffix,
              char *basename);
@@ -12,6 +12,8 @@
 
 #include "legacy-util-api.h"
 #include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h> /* access() */
 
@@ -99,6 +101,56 @@ tmpf(char *ignored)
   return tmpfile();
 }
 
+FILE *
+memf_open(MEMFILE *mf)
+{
+  mf->base = NULL;
+  mf->size = 0;
+  mf->inmem = 0;
+#if !defined(HOST_WIN)
+  mf->file = open_memstream(&mf->base, &mf->size);
+  if (mf->file != NULL) {
+    mf->inmem = 1;
+    return mf->file;
+  }
+#endif
+  mf->file = tmpfile();
+  return mf->file;
+}
+
+FILE *
+memf_rewind(MEMFILE *mf)
+{
+  if (!mf->inmem) {
+    rewind(mf->file);
+    return mf->file;
+  }
+  /* closing the writer finalizes base and size */
+  fclose(mf->file);
+  mf->inmem = 0;
+  if (mf->size == 0) {
+    /* fmemopen(3) may reject an empty buffer */
+    free(mf->base);
+    mf->base = NULL;
+    mf->file = tmpfile();
+  } else {
+    mf->file = fmemopen(mf->base, mf->size, "r");
+  }
+  return mf->file;
+}
+
+void
+memf_close(MEMFILE *mf)
+{
+  if (mf->file != NULL)
+    fclose(mf->file);
+  free(mf->base);
+  mf->file = NULL;
+  mf->base = NULL;
+  mf->size = 0;
+  mf->inmem = 0;
+}
+
 char *
 mkperm(char *pattern, const char *oldext, const char *newext)
 {
@@ -0,0 +1,78 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+/* clang-format off */
+
+/* mmteam.c -- F90 fast MATMUL intrinsics called by every thread of an
+ * OpenMP team, as in a WORKSHARE construct.  Each thread computes its share
+ * of C with the serial routine; the caller supplies the barrier after.
+ */
+
+#include "stdioInterf.h"
+#include "fioMacros.h"
+#include "complex.h"
+#include "komp.h"
+
+/* Divide n rows or columns among the team; return this thread's count
+ * and its first one in *lo.
+ */
+static __POINT_T
+team_share(__POINT_T n, __POINT_T *lo)
+{
+  __POINT_T nthreads, tid, chunk, extra;
+
+  nthreads = omp_get_num_threads();
+  tid = omp_get_thread_num();
+  chunk = n / nthreads;
+  extra = n % nthreads;
+  if (tid < extra) {
+    *lo = tid * (chunk + 1);
+    return chunk + 1;
+  }
+  *lo = tid * chunk + extra;
+  return chunk;
+}
+
+/* C = op(A) * op(B) is split by columns of C, which need just those columns
+ * of op(B), unless C has more rows than columns, when it is split by rows
+ * of C, which need just those rows of op(A).  Consecutive columns of B are
+ * ldb elements apart and consecutive columns of B**T (rows of B) are one
+ * element apart; likewise for A.
+ */
+#define MMUL_TEAM(UTEAM, LTEAM, USER, LSER, T)                                \
+  void ENTF90(USER, LSER)(int, int, __POINT_T, __POINT_T, __POINT_T, T *,     \
+                          T[], __POINT_T, T[], __POINT_T, T *, T[],           \
+                          __POINT_T);                                         \
+                                                                              \
+  void ENTF90(UTEAM, LTEAM)(int ta, int tb, __POINT_T mra, __POINT_T ncb,     \
+                            __POINT_T kab, T *alpha, T a[], __POINT_T lda,    \
+                            T b[], __POINT_T ldb, T *beta, T c[],             \
+                            __POINT_T ldc)                                    \
+  {                                                                           \
+    __POINT_T lo, cnt;                                                        \
+                                                                              \
+    if (ncb >= mra) {                                                         \
+      cnt = team_share(ncb, &lo);                                             \
+      if (cnt > 0)                                                            \
+        ENTF90(USER, LSER)(ta, tb, mra, cnt, kab, alpha, a, lda,              \
+                           b + (tb ? lo : lo * ldb), ldb, beta, c + lo * ldc, \
+                           ldc);                                              \
+    } else {                                                                  \
+      cnt = team_share(mra, &lo);                                             \
+      if (cnt > 0)                                                            \
+        ENTF90(USER, LSER)(ta, tb, cnt, ncb, kab, alpha,                      \
+                           a + (ta ? lo * lda : lo), lda, b, ldb, beta,       \
+                           c + lo, ldc);                                      \
+    }                                                                         \
+  }
+
+MMUL_TEAM(MMUL_REAL4_TEAM, mmul_real4_team, MMUL_REAL4, mmul_real4, float)
+MMUL_TEAM(MMUL_REAL8_TEAM, mmul_real8_team, MMUL_REAL8, mmul_real8, double)
+MMUL_TEAM(MMUL_CMPLX8_TEAM, mmul_cmplx8_team, MMUL_CMPLX8, mmul_cmplx8,
+          float complex)
+MMUL_TEAM(MMUL_CMPLX16_TEAM, mmul_cmplx16_team, MMUL_CMPLX16, mmul_cmplx16,
+          double complex)
@@ -433,6 +433,140 @@ _mp_copypriv_kmpc(void *dest, void *src)
   }
 }
 
+/* Reduction operators and element types, and the layout of the info word.
+ * These are a copy of the MP_RED_ values in tools/shared/mp.h, which the
+ * compiler uses to describe each reduction item; change both together.
+ */
+#define MP_RED_ADD 1
+#define MP_RED_MUL 2
+#define MP_RED_MAX 3
+#define MP_RED_MIN 4
+#define MP_RED_IAND 5
+#define MP_RED_IOR 6
+#define MP_RED_IEOR 7
+
+#define MP_RED_I1 1
+#define MP_RED_I2 2
+#define MP_RED_I4 3
+#define MP_RED_I8 4
+#define MP_RED_R4 5
+#define MP_RED_R8 6
+#define MP_RED_C8 7
+#define MP_RED_C16 8
+
+#define MP_RED_TYPE_SHIFT 8
+#define MP_RED_CNT_SHIFT 16
+
+#define RED_LOOP(T, stmt)                                                      \
+  do {                                                                         \
+    T *d = (T *)to->data;                                                      \
+    const T *s = (const T *)from->data;                                        \
+    for (n = cnt; n > 0; --n, ++d, ++s)                                        \
+      stmt;                                                                    \
+  } while (0)
+
+#define RED_ARITH(T)                                                           \
+  case MP_RED_ADD:                                                             \
+    RED_LOOP(T, *d += *s);                                                     \
+    break;                                                                     \
+  case MP_RED_MUL:                                                             \
+    RED_LOOP(T, *d *= *s);                                                     \
+    break;                                                                     \
+  case MP_RED_MAX:                                                             \
+    RED_LOOP(T, if (*s > *d) *d = *s);                                         \
+    break;                                                                     \
+  case MP_RED_MIN:                                                             \
+    RED_LOOP(T, if (*s < *d) *d = *s);                                         \
+    break;
+
+#define RED_BITS(T)                                                            \
+  case MP_RED_IAND:                                                            \
+    RED_LOOP(T, *d &= *s);                                                     \
+    break;                                                                     \
+  case MP_RED_IOR:                                                             \
+    RED_LOOP(T, *d |= *s);                                                     \
+    break;                                                                     \
+  case MP_RED_IEOR:                                                            \
+    RED_LOOP(T, *d ^= *s);                                                     \
+    break;
+
+#define RED_CMPLX(T)                                                           \
+  case MP_RED_ADD:                                                             \
+    RED_LOOP(T, (d->r += s->r, d->i += s->i));                                 \
+    break;                                                                     \
+  case MP_RED_MUL:                                                             \
+    RED_LOOP(T, {                                                              \
+      T t = *d;                                                                \
+      d->r = t.r * s->r - t.i * s->i;                                          \
+      d->i = t.r * s->i + t.i * s->r;                                          \
+    });                                                                        \
+    break;
+
+/* Handler for __kmpc_reduce_nowait 'reduce_func': combine the private
+ * copies listed in src into those listed in dest.  See how we marshall
+ * the data in reduceItemInfo() and makeCopyprivArray() in expsmp.cpp.
+ */
+void
+_mp_reduce_kmpc(void *dest, void *src)
+{
+  struct pair_t {size_t info; void *data;};
+  struct cmplx8_t {float r, i;};
+  struct cmplx16_t {double r, i;};
+  const struct pair_t *to   = (struct pair_t *)dest;
+  const struct pair_t *from = (struct pair_t *)src;
+  size_t cnt, n;
+
+  for ( ; from->info; ++from, ++to) {
+    cnt = from->info >> MP_RED_CNT_SHIFT;
+    switch ((from->info >> MP_RED_TYPE_SHIFT) & 0xff) {
+    case MP_RED_I1:
+      switch (from->info & 0xff) {
+      RED_ARITH(int8_t)
+      RED_BITS(int8_t)
+      }
+      break;
+    case MP_RED_I2:
+      switch (from->info & 0xff) {
+      RED_ARITH(int16_t)
+      RED_BITS(int16_t)
+      }
+      break;
+    case MP_RED_I4:
+      switch (from->info & 0xff) {
+      RED_ARITH(int32_t)
+      RED_BITS(int32_t)
+      }
+      break;
+    case MP_RED_I8:
+      switch (from->info & 0xff) {
+      RED_ARITH(int64_t)
+      RED_BITS(int64_t)
+      }
+      break;
+    case MP_RED_R4:
+      switch (from->info & 0xff) {
+      RED_ARITH(float)
+      }
+      break;
+    case MP_RED_R8:
+      switch (from->info & 0xff) {
+      RED_ARITH(double)
+      }
+      break;
+    case MP_RED_C8:
+      switch (from->info & 0xff) {
+      RED_CMPLX(struct cmplx8_t)
+      }
+      break;
+    case MP_RED_C16:
+      switch (from->info & 0xff) {
+      RED_CMPLX(struct cmplx16_t)
+      }
+      break;
+    }
+  }
+}
+
 /* duplicate kmpc_threadprivate_cached but we assume each thread has its own addr
  * in its own [tls] address space so that it does not need to access memory in other
  * thread's area. Use when experiment flag 69,0x80
@@ -0,0 +1,366 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+
+"""
+Compile-time benchmark for flang1 and flang2.
+
+The script writes a set of stress inputs, compiles each of them with
+flang1 and flang2 and writes a JSON summary of phase times, memory and
+table sizes. Each case stresses a part of the compiler whose cost grows
+with the size of the input:
+
+  data_init     large DATA initializers (semant, dinit, llassem)
+  module_procs  one module with hundreds of module procedures
+  use_chain     a chain of modules, each in its own file, each using
+                the one before it (module read and write)
+  generic       a generic interface with hundreds of specifics
+  unrolled      a loop whose body is thousands of statements long
+                (expand, cgmain)
+  host          a host with hundreds of internal procedures
+
+The inputs are generated and do not depend on the time or the platform,
+so results for the same --scale can be compared over time. The numbers
+come from the -phasestats records of each compile. Use --baseline to
+compare against an earlier summary. The script exits with status 1 if
+the CPU time of a case grew by more than --threshold percent.
+
+Typical use, from the build tree:
+
+	python compile_time.py --bindir bin --workdir ct --output new.json
+	python compile_time.py --bindir bin --workdir ct --output new.json \\
+		--baseline old.json
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+def main():
+	args = processArgs()
+	if not os.path.isdir(args.workdir):
+		os.makedirs(args.workdir)
+	cases = [c for c in CASES if not args.cases or c[0] in args.cases]
+	summary = {"scale": args.scale, "opt": args.opt, "repeat": args.repeat,
+		"cases": {}}
+	for name, generate in cases:
+		files = generate(args.scale)
+		summary["cases"][name] = runCase(args, name, files)
+		printCase(name, summary["cases"][name])
+	if args.output:
+		with open(args.output, "w") as handle:
+			json.dump(summary, handle, indent=1, sort_keys=True)
+			handle.write("\n")
+	if args.baseline:
+		with open(args.baseline, "r") as handle:
+			baseline = json.load(handle)
+		if not compare(baseline, summary, args.threshold):
+			sys.exit(1)
+
+def processArgs():
+	""" Process command line arguments """
+
+	parser = argparse.ArgumentParser(
+		description="Measure flang1 and flang2 compile time on stress inputs")
+	parser.add_argument("--bindir", required=True,
+		help="directory containing flang1 and flang2")
+	parser.add_argument("--workdir", required=True,
+		help="directory for the generated inputs and compiler output")
+	parser.add_argument("--output", help="write the JSON summary here")
+	parser.add_argument("--baseline", help="compare with this JSON summary")
+	parser.add_argument("--threshold", type=float, default=10.0,
+		help="percent increase in CPU time reported as a regression")
+	parser.add_argument("--scale", type=int, default=1,
+		help="multiply the size of every input by this")
+	parser.add_argument("--opt", type=int, default=2, help="optimization level")
+	parser.add_argument("--repeat", type=int, default=3,
+		help="compile each case this many times and keep the fastest")
+	parser.add_argument("--case", dest="cases", action="append",
+		help="run only this case (may be repeated)")
+	parser.add_argument("--flang1-arg", dest="flang1_args", action="append",
+		default=[], help="extra argument for flang1 (may be repeated)")
+	parser.add_argument("--flang2-arg", dest="flang2_args", action="append",
+		default=[], help="extra argument for flang2 (may be repeated)")
+	return parser.parse_args()
+
+# ---------------------------------------------------------------------------
+# Input generators. Each returns a list of (file name, source text) pairs to
+# be compiled in order.
+
+def genDataInit(scale):
+	n = 20000 * scale
+	lines = ["module data_init",
+		"  integer, parameter :: n = %d" % n,
+		"  integer :: a(n)",
+		"  real :: r(n), z(n)",
+		"  type pt",
+		"    integer :: i",
+		"    real :: x, y",
+		"  end type",
+		"  type(pt) :: p(n / 10)",
+		"  integer :: i"]
+	# explicit values, 100 to a statement
+	for first in range(1, n + 1, 100):
+		last = min(first + 99, n)
+		values = [str((k * 7919) % 100003) for k in range(first, last + 1)]
+		lines.append("  data a(%d:%d) / &" % (first, last))
+		for k in range(0, len(values), 10):
+			sep = ", &" if k + 10 < len(values) else " /"
+			lines.append("    " + ", ".join(values[k:k + 10]) + sep)
+	# repeat counts and implied DO
+	lines.append("  data r / %d*1.5 /" % n)
+	lines.append("  data (z(i), i = 1, n, 2) / %d*0.0 /" % ((n + 1) // 2))
+	lines.append("  data (z(i), i = 2, n, 2) / %d*-1.0 /" % (n // 2))
+	lines.append("  data p / %d*pt(1, 2.0, 3.0) /" % (n // 10))
+	lines.append("end module")
+	return [("data_init.f90", "\n".join(lines) + "\n")]
+
+def genModuleProcs(scale):
+	n = 500 * scale
+	lines = ["module module_procs", "  implicit none", "contains"]
+	for k in range(1, n + 1):
+		lines += ["  subroutine p%d(x, y)" % k,
+			"    real, intent(inout) :: x(:)",
+			"    real, intent(in) :: y",
+			"    x = x * y + %d.0" % k]
+		if k > 1:
+			lines.append("    if (x(1) > y) call p%d(x, y - 1.0)" % (k - 1))
+		lines.append("  end subroutine")
+	lines.append("end module")
+	return [("module_procs.f90", "\n".join(lines) + "\n")]
+
+def genUseChain(scale):
+	n = 100 * scale
+	files = []
+	for k in range(1, n + 1):
+		lines = ["module chain%d" % k]
+		if k > 1:
+			lines.append("  use chain%d" % (k - 1))
+		lines += ["  implicit none",
+			"  integer, parameter :: k%d = %d" % (k, k),
+			"  type t%d" % k]
+		if k > 1:
+			lines.append("    type(t%d) :: parent" % (k - 1))
+		lines += ["    real :: v(%d)" % (k % 8 + 1),
+			"  end type",
+			"  type(t%d), save :: g%d" % (k, k),
+			"contains",
+			"  function f%d(x) result(r)" % k,
+			"    type(t%d), intent(in) :: x" % k,
+			"    real :: r",
+			"    r = sum(x%v)"]
+		if k > 1:
+			lines.append("    r = r + f%d(x%%parent)" % (k - 1))
+		lines += ["  end function", "end module"]
+		files.append(("chain%d.f90" % k, "\n".join(lines) + "\n"))
+	files.append(("chain_main.f90", "\n".join([
+		"program chain_main",
+		"  use chain%d" % n,
+		"  print *, f%d(g%d), k%d" % (n, n, n),
+		"end program"]) + "\n"))
+	return files
+
+def genGeneric(scale):
+	n = 200 * scale
+	lines = ["module generic", "  implicit none"]
+	for k in range(1, n + 1):
+		lines += ["  type g%d" % k, "    integer :: v = %d" % k, "  end type"]
+	lines.append("  interface gen")
+	for k in range(1, n + 1):
+		lines.append("    module procedure s%d" % k)
+	lines += ["  end interface", "contains"]
+	for k in range(1, n + 1):
+		lines += ["  subroutine s%d(x, i)" % k,
+			"    type(g%d), intent(inout) :: x" % k,
+			"    integer, intent(in) :: i",
+			"    x%v = x%v + i",
+			"  end subroutine"]
+	lines += ["  subroutine use_all()"]
+	for k in range(1, n + 1):
+		lines.append("    type(g%d) :: x%d" % (k, k))
+	for k in range(1, n + 1):
+		lines.append("    call gen(x%d, %d)" % (k, k))
+	lines += ["  end subroutine", "end module"]
+	return [("generic.f90", "\n".join(lines) + "\n")]
+
+def genUnrolled(scale):
+	n = 2000 * scale
+	lines = ["subroutine unrolled(a, b, c, m)",
+		"  integer :: m, i",
+		"  real :: a(m + %d), b(%d), c" % (n, n),
+		"  do i = 1, m"]
+	for k in range(1, n + 1):
+		lines.append("    a(i + %d) = a(i + %d) * b(%d) + c" % (k - 1, k, k))
+	lines += ["  end do", "end subroutine"]
+	return [("unrolled.f90", "\n".join(lines) + "\n")]
+
+def genHost(scale):
+	n = 500 * scale
+	lines = ["subroutine host(m)",
+		"  integer :: m",
+		"  real :: h(100), s",
+		"  integer :: cnt"]
+	for k in range(1, n + 1):
+		lines.append("  call c%d()" % k)
+	lines.append("contains")
+	for k in range(1, n + 1):
+		lines += ["  subroutine c%d()" % k,
+			"    integer :: j",
+			"    do j = 1, m",
+			"      h(mod(j + %d, 100) + 1) = h(mod(j, 100) + 1) + s" % k,
+			"    end do",
+			"    cnt = cnt + %d" % k,
+			"  end subroutine"]
+	lines.append("end subroutine")
+	return [("host.f90", "\n".join(lines) + "\n")]
+
+CASES = [
+	("data_init", genDataInit),
+	("module_procs", genModuleProcs),
+	("use_chain", genUseChain),
+	("generic", genGeneric),
+	("unrolled", genUnrolled),
+	("host", genHost),
+]
+
+# ---------------------------------------------------------------------------
+
+def runCase(args, name, files):
+	"""
+	Compile the files of a case, args.repeat times, and summarize the
+	fastest run
+
+	:param args: command line arguments
+	:param name: name of the case
+	:param files: list of (file name, source text) pairs
+	"""
+
+	casedir = os.path.join(args.workdir, name)
+	if not os.path.isdir(casedir):
+		os.makedirs(casedir)
+	for fname, text in files:
+		with open(os.path.join(casedir, fname), "w") as handle:
+			handle.write(text)
+	best = None
+	for i in range(args.repeat):
+		stats = os.path.join(casedir, "phasestats.json")
+		if os.path.exists(stats):
+			os.remove(stats)
+		for fname, text in files:
+			compileFile(args, casedir, fname, stats)
+		result = summarize(stats)
+		if best is None or result["cpu_ms"] < best["cpu_ms"]:
+			best = result
+	best["lines"] = sum([text.count("\n") for fname, text in files])
+	best["files"] = len(files)
+	return best
+
+def compileFile(args, casedir, fname, stats):
+	"""
+	Run flang1 and flang2 on one file
+
+	:param args: command line arguments
+	:param casedir: directory holding the file; the compilers run here
+	:param fname: name of the file
+	:param stats: -phasestats file
+	"""
+
+	base = os.path.splitext(fname)[0]
+	target = ["-tp", "px", "-quad", "-x", "19", "0x400000", "-x", "124", "0x1000"]
+	flang1 = [os.path.join(args.bindir, "flang1"), fname,
+		"-opt", str(args.opt), "-terse", "1", "-inform", "warn", "-nohpf",
+		"-nostatic", "-freeform",
+		"-vect", "48", "-def", "unix", "-def", "__linux__",
+		"-def", "__x86_64__"] + target + [
+		"-stbfile", base + ".stb", "-modexport", base + ".cmod",
+		"-modindex", base + ".cmdx", "-output", base + ".ilm",
+		"-phasestats", "phasestats.json"] + args.flang1_args
+	flang2 = [os.path.join(args.bindir, "flang2"), base + ".ilm",
+		"-opt", str(args.opt), "-fn", fname, "-astype", "0"] + target + [
+		"-stbfile", base + ".stb", "-asm", base + ".ll",
+		"-phasestats", "phasestats.json"] + args.flang2_args
+	for command in (flang1, flang2):
+		proc = subprocess.Popen(command, cwd=casedir, stdout=subprocess.PIPE,
+			stderr=subprocess.STDOUT)
+		out = proc.communicate()[0]
+		if proc.returncode != 0:
+			sys.stdout.write(out.decode("utf-8", "replace"))
+			sys.exit("%s failed on %s" % (os.path.basename(command[0]),
+				os.path.join(casedir, fname)))
+
+def summarize(stats):
+	"""
+	Add up the -phasestats records of one run of a case
+
+	:param stats: -phasestats file
+	"""
+
+	result = {"wall_ms": 0.0, "cpu_ms": 0.0, "maxrss_kb": 0,
+		"area_hiwater": 0, "phases": {}, "tables": {}}
+	with open(stats, "r") as handle:
+		for line in handle:
+			rec = json.loads(line)
+			tool = rec["tool"]
+			result["wall_ms"] += rec["wall_ms"]
+			result["cpu_ms"] += rec["cpu_ms"]
+			result["maxrss_kb"] = max(result["maxrss_kb"], rec["maxrss_kb"])
+			result["area_hiwater"] = max(result["area_hiwater"],
+				rec["area_hiwater"])
+			phase = tool + ":" + rec["phase"]
+			result["phases"][phase] = result["phases"].get(phase, 0.0) + \
+				rec["cpu_ms"]
+			for table, size in rec["tables"].items():
+				table = tool + ":" + table
+				result["tables"][table] = max(result["tables"].get(table, 0),
+					size)
+	for phase in result["phases"]:
+		result["phases"][phase] = round(result["phases"][phase], 3)
+	result["wall_ms"] = round(result["wall_ms"], 3)
+	result["cpu_ms"] = round(result["cpu_ms"], 3)
+	return result
+
+def printCase(name, result):
+	""" Print the totals and the most expensive phases of a case """
+
+	sys.stdout.write("%-13s %10.1f ms cpu %10.1f ms wall %8d KB rss\n" % (
+		name, result["cpu_ms"], result["wall_ms"], result["maxrss_kb"]))
+	phases = sorted(result["phases"].items(), key=lambda p: -p[1])
+	for phase, ms in phases[:3]:
+		sys.stdout.write("    %-30s %10.1f ms\n" % (phase, ms))
+
+def compare(baseline, summary, threshold):
+	"""
+	Print the change from baseline for each case. Return False if the CPU
+	time of any case grew by more than threshold percent.
+
+	:param baseline: earlier summary
+	:param summary: this summary
+	:param threshold: percent increase in CPU time allowed
+	"""
+
+	if baseline.get("scale") != summary["scale"] or \
+			baseline.get("opt") != summary["opt"]:
+		sys.stdout.write("warning: baseline has different scale or opt\n")
+	ok = True
+	for name in sorted(summary["cases"]):
+		old = baseline["cases"].get(name)
+		if old is None or old["cpu_ms"] <= 0:
+			continue
+		new = summary["cases"][name]
+		change = 100.0 * (new["cpu_ms"] - old["cpu_ms"]) / old["cpu_ms"]
+		rss = 100.0 * (new["maxrss_kb"] - old["maxrss_kb"]) / \
+			max(old["maxrss_kb"], 1)
+		flag = ""
+		if change > threshold:
+			flag = "  REGRESSION"
+			ok = False
+		sys.stdout.write("%-13s cpu %+7.1f%%  rss %+7.1f%%%s\n" % (
+			name, change, rss, flag))
+	return ok
+
+if __name__ == "__main__":
+	main()
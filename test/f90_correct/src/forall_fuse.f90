@@ -0,0 +1,91 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+! Adjacent foralls and the statements of a block WHERE are fused, and the
+! WHERE mask temp is contracted to a scalar; a mask that reads the earlier
+! LHS through a vector subscript must keep the loops apart.
+
+subroutine fused_where(a, b, c)
+  real :: a(20), b(20), c(20)
+  where (a > 2.0)
+    a = b + c
+    c = a * 2.0
+  end where
+end subroutine
+
+subroutine fused_forall(a, b, c)
+  real :: a(20), b(20), c(20)
+  integer :: i
+  forall (i = 1:20) a(i) = b(i) + c(i)
+  forall (i = 1:20, a(i) > 0.0) c(i) = a(i) * 2.0
+end subroutine
+
+subroutine indirect_forall(a, b, c, idx)
+  real :: a(20), b(20), c(20)
+  integer :: idx(20), i
+  forall (i = 1:20) b(i) = a(i) - 2.0
+  forall (i = 1:20, b(idx(i)) > 0.0) c(i) = b(idx(i))
+end subroutine
+
+program forall_fuse
+  integer, parameter :: n = 20
+  real :: a(n), b(n), c(n), ea(n), eb(n), ec(n)
+  real :: res(9*n), expect(9*n)
+  integer :: idx(n), i
+
+  do i = 1, n
+    a(i) = mod(i * 7, 5)
+    b(i) = i - 10
+    c(i) = 3 - mod(i, 4)
+    idx(i) = n + 1 - i
+  enddo
+
+  ea = a
+  eb = b
+  ec = c
+  do i = 1, n
+    if (ea(i) > 2.0) then
+      ea(i) = eb(i) + ec(i)
+      ec(i) = ea(i) * 2.0
+    endif
+  enddo
+  call fused_where(a, b, c)
+  res(1:n) = a
+  res(n+1:2*n) = b
+  res(2*n+1:3*n) = c
+  expect(1:n) = ea
+  expect(n+1:2*n) = eb
+  expect(2*n+1:3*n) = ec
+
+  do i = 1, n
+    ea(i) = eb(i) + ec(i)
+  enddo
+  do i = 1, n
+    if (ea(i) > 0.0) ec(i) = ea(i) * 2.0
+  enddo
+  call fused_forall(a, b, c)
+  res(3*n+1:4*n) = a
+  res(4*n+1:5*n) = b
+  res(5*n+1:6*n) = c
+  expect(3*n+1:4*n) = ea
+  expect(4*n+1:5*n) = eb
+  expect(5*n+1:6*n) = ec
+
+  do i = 1, n
+    eb(i) = ea(i) - 2.0
+  enddo
+  do i = 1, n
+    if (eb(idx(i)) > 0.0) ec(i) = eb(idx(i))
+  enddo
+  call indirect_forall(a, b, c, idx)
+  res(6*n+1:7*n) = a
+  res(7*n+1:8*n) = b
+  res(8*n+1:9*n) = c
+  expect(6*n+1:7*n) = ea
+  expect(7*n+1:8*n) = eb
+  expect(8*n+1:9*n) = ec
+
+  call checkf(res, expect, 9*n)
+end program
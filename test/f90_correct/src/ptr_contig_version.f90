@@ -0,0 +1,74 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+! Loops over pointer arrays are versioned on the stride of each pointer
+! target; check both the unit-stride copy and the general copy.
+
+subroutine scale(p, q, n)
+  real, pointer :: p(:), q(:)
+  integer :: n, i
+  do i = 1, n
+    p(i) = 2.0 * q(i) + i
+  end do
+end subroutine
+
+program ptr_contig_version
+  interface
+    subroutine scale(p, q, n)
+      real, pointer :: p(:), q(:)
+      integer :: n
+    end subroutine
+  end interface
+  integer, parameter :: n = 8
+  integer :: i
+  real, target :: a(2*n), b(2*n), c(2, n)
+  real, pointer :: p(:), q(:)
+  real :: res(5*n), expect(5*n)
+
+  b = [(real(i), i = 1, 2*n)]
+
+  ! Both targets contiguous.
+  a = 0.0
+  p => a(1:n)
+  q => b(1:n)
+  call scale(p, q, n)
+  res(1:n) = a(1:n)
+  expect(1:n) = [(3.0*i, i = 1, n)]
+
+  ! Strided pointer target takes the general copy.
+  a = 0.0
+  p => a(1:2*n:2)
+  call scale(p, q, n)
+  res(n+1:2*n) = a(1:2*n:2)
+  expect(n+1:2*n) = [(3.0*i, i = 1, n)]
+  if (any(a(2:2*n:2) /= 0.0)) expect(n+1) = -1.0
+
+  ! Strided source, contiguous destination.
+  a = 0.0
+  p => a(1:n)
+  q => b(2:2*n:2)
+  call scale(p, q, n)
+  res(2*n+1:3*n) = a(1:n)
+  expect(2*n+1:3*n) = [(5.0*i, i = 1, n)]
+
+  ! Row of a rank-2 array.
+  c = 0.0
+  p => c(2, :)
+  q => b(1:n)
+  call scale(p, q, n)
+  res(3*n+1:4*n) = c(2, :)
+  expect(3*n+1:4*n) = [(3.0*i, i = 1, n)]
+  if (any(c(1, :) /= 0.0)) expect(3*n+1) = -1.0
+
+  ! Contiguous again after a strided call.
+  a = 0.0
+  p => a(n+1:2*n)
+  q => b(n+1:2*n)
+  call scale(p, q, n)
+  res(4*n+1:5*n) = a(n+1:2*n)
+  expect(4*n+1:5*n) = [(2.0*(n+i) + i, i = 1, n)]
+
+  call checkf(res, expect, 5*n)
+end program
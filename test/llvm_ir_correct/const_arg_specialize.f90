@@ -0,0 +1,76 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+
+! RUN: %flang -O2 -S -emit-llvm %s -o - | FileCheck %s
+! RUN: %flang -O2 -Hx,47,0x800 -S -emit-llvm %s -o - | FileCheck %s -check-prefix=NOSPEC
+
+!! At -O2 a subprogram whose dummies only ever receive integer constants is
+!! given a guarded copy of its body per constant set, with the constants
+!! folded into each copy.
+subroutine host(a, r)
+  real :: a(64), r(2)
+  r(1) = inner(8, 3)
+  r(2) = inner(16, 5)
+contains
+  real function inner(n, k)
+    integer, intent(in) :: n, k
+    integer :: i
+    inner = 0
+    do i = 1, n
+      inner = inner + a(i) * k
+    end do
+  end function
+end subroutine
+! CHECK-LABEL: define internal float @host_inner(
+! CHECK: icmp ne i32 %{{[0-9]+}}, 8
+! CHECK: icmp ne i32 %{{[0-9]+}}, 3
+! CHECK: store i32 8, i32* %.dY
+! CHECK: fmul fast float %{{[0-9]+}}, 0x4008000000000000
+! CHECK: icmp ne i32 %{{[0-9]+}}, 16
+! CHECK: icmp ne i32 %{{[0-9]+}}, 5
+! CHECK: store i32 16, i32* %.dY
+! CHECK: fmul fast float %{{[0-9]+}}, 0x4014000000000000
+! CHECK-LABEL: define void @callers_(
+! NOSPEC-LABEL: define internal float @host_inner(
+! NOSPEC-NOT: icmp ne
+! NOSPEC-LABEL: define void @callers_(
+
+subroutine callers(x)
+  integer :: x(4)
+  call assigned(4)
+  call passed(4)
+  call labelled(4, x)
+end subroutine
+
+!! A dummy that is stored to, passed on to another call, or read in a body
+!! with a statement label keeps the general body only.
+subroutine assigned(n)
+  integer :: n, i
+  do i = 1, n
+    call foo(i)
+  end do
+  n = 0
+end subroutine
+! CHECK-LABEL: define void @assigned_(
+! CHECK-NOT: icmp ne
+
+subroutine passed(n)
+  integer :: n
+  call bar(n)
+end subroutine
+! CHECK-LABEL: define void @passed_(
+! CHECK-NOT: icmp ne
+
+subroutine labelled(n, x)
+  integer :: n, x(4), i
+  i = 0
+10 i = i + 1
+  x(i) = n
+  if (i < n) goto 10
+end subroutine
+! CHECK-LABEL: define void @labelled_(
+! CHECK-NOT: icmp ne
+! CHECK: ret void
@@ -0,0 +1,37 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+
+! RUN: %flang -S -emit-llvm %s -o - | FileCheck %s
+
+!! Initialized bytes are written as a c"..." string, an all-zero member as
+!! zeroinitializer, and a run of 64 or more zero bytes between initialized
+!! data becomes a zeroinitializer member of its own.
+
+! CHECK: %struct_tabs_{{[0-9]+}}_ = type < { [16 x i8] , [128 x i8] , [88 x i8]  } >
+! CHECK: @_tabs_{{[0-9]+}}_ = global %struct_tabs_{{[0-9]+}}_ < { [16 x i8]  c"Hello\00\0A!\00\00\00\00\00\00\00\00" ,  [128 x i8]  zeroinitializer ,  [88 x i8]  c"\07\00\00\00{{(\\00)+}}abcd"  } >
+module tabs
+  integer(1) :: bytes(8) = [72, 101, 108, 108, 111, 0, 10, 33]
+  real :: zeros(32) = 0.0
+  type mixed
+    integer :: id
+    real :: pad(20)
+    character(4) :: tag
+  end type
+  type(mixed) :: m = mixed(7, 0.0, 'abcd')
+end module
+
+! CHECK: %struct.[[ST:STATICS[0-9]+]] = type <{ [4 x i8] , [152 x i8] , [10 x i8]  }>
+! CHECK: @.[[ST]] = internal global %struct.[[ST]] <{ [4 x i8]  c"\01\00\00\00" ,  [152 x i8]  zeroinitializer ,  [10 x i8]  c"\02\00\00\00hi \22x "  }>
+subroutine s(k, r)
+  integer :: k
+  integer :: gap(40)
+  character(6) :: msg
+  integer :: r
+  save
+  data gap(1) /1/, gap(40) /2/
+  data msg /'hi "x'/
+  r = gap(k) + len(msg)
+end subroutine
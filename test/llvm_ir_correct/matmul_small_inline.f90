@@ -0,0 +1,55 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+
+! RUN: %flang -O2 -S -emit-llvm %s -o - | FileCheck %s
+
+!! A MATMUL of at most 64 multiplies is expanded inline.  When the
+!! destination cannot overlap an operand the results are stored straight
+!! into it, and a TRANSPOSE() operand is expanded in place.
+subroutine mt(a, b, c)
+  real :: a(4,4), b(4,4), c(4,4)
+  a = matmul(b, transpose(c))
+end subroutine
+! CHECK-LABEL: define void @mt_(
+! CHECK-NOT: alloca
+! CHECK-NOT: call
+! CHECK-COUNT-16: store float %{{[0-9]+}}, float* %{{[0-9]+}}
+! CHECK-NOT: store
+! CHECK-NOT: call
+! CHECK: ret void
+
+!! The destination is also an operand, so the products go through a temp.
+subroutine self(a, b)
+  real :: a(4,4), b(4,4)
+  a = matmul(a, b)
+end subroutine
+! CHECK-LABEL: define void @self_(
+! CHECK: alloca [16 x float]
+! CHECK-COUNT-64: fmul fast float
+! CHECK: ret void
+
+!! 4x4x4 is exactly the 64-multiply limit.
+subroutine mm(a, b, c)
+  real :: a(4,4), b(4,4), c(4,4)
+  a = matmul(b, c)
+end subroutine
+! CHECK-LABEL: define void @mm_(
+! CHECK-NOT: alloca
+! CHECK-COUNT-64: fmul fast float
+! CHECK-NOT: fmul
+! CHECK-NOT: call
+! CHECK: ret void
+
+!! 4x5x4 is over the limit and still calls the runtime.
+subroutine big(a, b, c)
+  real :: a(4,4), b(4,5), c(5,4)
+  a = matmul(b, c)
+end subroutine
+! CHECK-LABEL: define void @big_(
+! CHECK-NOT: fmul
+! CHECK: @f90_mmul_real4
+! CHECK-NOT: fmul
+! CHECK: ret void
@@ -10,7 +10,7 @@ do j=1,100
 end do
 !$omp end parallel do
 end subroutine
-! //CHECK: atomicrmw
+! //CHECK: __kmpc_reduce_nowait
 
 subroutine atomic_logical_1(n,val)
 logical(kind=1) :: lg = .FALSE.
@@ -0,0 +1,38 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+
+! RUN: %flang -fopenmp -S -emit-llvm %s -o - | FileCheck %s
+! RUN: %flang -fopenmp -Hx,69,0x2000 -S -emit-llvm %s -o - | FileCheck %s -check-prefix=NOKMPC
+
+!! The combine of a reduction is handed to __kmpc_reduce_nowait with the
+!! _mp_reduce_kmpc combiner; only a return of 1 runs the inline combine,
+!! which is then closed by __kmpc_end_reduce_nowait.
+subroutine sum_reduce(a, n, s)
+  integer :: n, i
+  real :: a(n), s
+  s = 0.0
+!$omp parallel do reduction(+: s)
+  do i = 1, n
+    s = s + a(i)
+  end do
+!$omp end parallel do
+end subroutine
+! CHECK-LABEL: define internal void @__nv_sum_reduce_
+! CHECK: [[COMB:%[0-9]+]] = bitcast i32 (...)* @_mp_reduce_kmpc to i64*
+! CHECK: [[RES:%[0-9]+]] = call i32 @__kmpc_reduce_nowait{{ ?}}(i64* %{{[0-9]+}}, i32 %{{[0-9]+}}, i32 1, i64 {{[0-9]+}}, i64* %{{[0-9]+}}, i64* [[COMB]], i64* %{{[0-9]+}})
+! CHECK-NEXT: [[CMP:%[0-9]+]] = icmp ne i32 [[RES]], 1
+! CHECK-NEXT: br i1 [[CMP]], label %[[DONE:L.LB[0-9_]+]], label %[[ONE:L.LB[0-9_]+]]
+! CHECK: [[ONE]]:
+! CHECK: fadd
+! CHECK: call void @__kmpc_end_reduce_nowait{{ ?}}(
+! CHECK-NEXT: br label %[[DONE]]
+! CHECK: [[DONE]]:
+! CHECK-NEXT: ret void
+
+! NOKMPC-LABEL: define internal void @__nv_sum_reduce_
+! NOKMPC-NOT: __kmpc_reduce_nowait
+! NOKMPC: cmpxchg
+! NOKMPC-NOT: __kmpc_reduce_nowait
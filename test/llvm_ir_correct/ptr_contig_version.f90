@@ -0,0 +1,52 @@
+!
+! Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+! See https://llvm.org/LICENSE.txt for license information.
+! SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+!
+
+! RUN: %flang -O2 -S -emit-llvm %s -o - | FileCheck %s
+! RUN: %flang -O2 -Hx,47,0x400 -S -emit-llvm %s -o - | FileCheck %s -check-prefix=NOVER
+
+!! At -O2 an innermost loop over pointer arrays is versioned on each
+!! array's descriptor: when the first dimension's lmult is 1 and the byte
+!! length is the element size, a clone indexes the arrays with unit stride.
+subroutine scale(p, q, n)
+  real, pointer :: p(:), q(:)
+  integer :: n, i
+  do i = 1, n
+    p(i) = 2.0 * q(i)
+  end do
+end subroutine
+! CHECK-LABEL: define void @scale_(
+!! The descriptor offsets of lmult and byte_len depend on the layout and
+!! the target; capture them from p's guards and expect the same for q.
+! CHECK: [[PSD:%[0-9]+]] = bitcast i{{[0-9]+}}* %p$sd to i8*
+! CHECK-NEXT: %{{[0-9]+}} = getelementptr i8, i8* [[PSD]], i{{[0-9]+}} [[LMULT:[0-9]+]]
+! CHECK: icmp ne i32 %{{[0-9]+}}, 1
+! CHECK-NEXT: br i1 %{{[0-9]+}}, label %[[SLOW:L.LB[0-9_]+]], label
+! CHECK: [[PSD2:%[0-9]+]] = bitcast i{{[0-9]+}}* %p$sd to i8*
+! CHECK-NEXT: getelementptr i8, i8* [[PSD2]], i{{[0-9]+}} [[BYTELEN:[0-9]+]]
+! CHECK: icmp ne i32 %{{[0-9]+}}, 4
+! CHECK-NEXT: br i1 %{{[0-9]+}}, label %[[SLOW]], label
+! CHECK: bitcast i{{[0-9]+}}* %q$sd to i8*
+! CHECK-NEXT: getelementptr i8, i8* %{{[0-9]+}}, i{{[0-9]+}} [[LMULT]]
+! CHECK: icmp ne i32 %{{[0-9]+}}, 1
+! CHECK-NEXT: br i1 %{{[0-9]+}}, label %[[SLOW]], label
+! CHECK: bitcast i{{[0-9]+}}* %q$sd to i8*
+! CHECK-NEXT: getelementptr i8, i8* %{{[0-9]+}}, i{{[0-9]+}} [[BYTELEN]]
+! CHECK: icmp ne i32 %{{[0-9]+}}, 4
+! CHECK-NEXT: br i1 %{{[0-9]+}}, label %[[SLOW]], label
+!! The unit-stride clone: no descriptor lmult or byte length in the loop.
+! CHECK-NOT: {{^}}[[SLOW]]:
+! CHECK: load float, float* %{{[0-9]+}}
+! CHECK-NOT: getelementptr i8, i8* %{{[0-9]+}}, i{{[0-9]+}} [[LMULT]]{{,|$}}
+! CHECK: store float %{{[0-9]+}}, float* %{{[0-9]+}}
+! CHECK-NOT: getelementptr i8, i8* %{{[0-9]+}}, i{{[0-9]+}} [[LMULT]]{{,|$}}
+!! The general copy still honours the descriptor.
+! CHECK: {{^}}[[SLOW]]:
+! CHECK: getelementptr i8, i8* %{{[0-9]+}}, i{{[0-9]+}} [[LMULT]]{{,|$}}
+! CHECK: ret void
+
+! NOVER-LABEL: define void @scale_(
+! NOVER-NOT: icmp ne i32
+! NOVER: ret void
@@ -0,0 +1,15 @@
+#
+# Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+ws_matmul: ws_matmul.$(OBJX)
+	@echo ------------ executing test $@
+	-$(RUN2) ./a.$(EXESUFFIX) $(LOG)
+ws_matmul.$(OBJX): $(SRC)/ws_matmul.f90 check.$(OBJX)
+	@echo ------------ building test $@
+	-$(F90) $(FFLAGS) $(SRC)/ws_matmul.f90
+	@$(RM) ./a.$(EXESUFFIX)
+	-$(F90) $(LDFLAGS) ws_matmul.$(OBJX) check.$(OBJX) $(LIBS) -o a.$(EXESUFFIX)
+build: ws_matmul
+run: ;
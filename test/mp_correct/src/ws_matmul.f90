@@ -0,0 +1,59 @@
+!* Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+!* See https://llvm.org/LICENSE.txt for license information.
+!* SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+!       OpenMP WORKSHARE
+!       MATMUL inside WORKSHARE is computed by the whole team; compare it
+!       with the same MATMUL outside the parallel region.
+
+program ws_matmul
+integer, parameter :: NTESTS=4
+integer, parameter :: m=37, k=23, n=41
+real(4) :: a4(m,k), b4(k,n), c4(m,n), s4(m,n)
+real(8) :: a8(m,k), b8(k,n), c8(m,n), s8(m,n)
+complex(4) :: az(m,k), bz(k,n), cz(m,n), sz(m,n)
+real(8) :: v8(k), w8(m), t8(m)
+integer :: i, j
+integer :: result(NTESTS), expect(NTESTS)
+
+do j = 1, k
+  do i = 1, m
+    a4(i,j) = mod(i + 2*j, 7) - 3
+    az(i,j) = cmplx(mod(i, 5), mod(j, 3) - 1)
+  enddo
+  v8(j) = mod(j, 4) + 1
+enddo
+do j = 1, n
+  do i = 1, k
+    b4(i,j) = mod(3*i + j, 5) - 2
+    bz(i,j) = cmplx(mod(i + j, 4) - 2, 1)
+  enddo
+enddo
+a8 = a4
+b8 = b4
+s4 = matmul(a4, b4)
+s8 = matmul(a8, b8)
+sz = matmul(az, bz)
+t8 = matmul(a8, v8)
+
+c4 = 0
+c8 = 0
+cz = 0
+w8 = 0
+!$omp parallel
+!$omp workshare
+c4 = matmul(a4, b4)
+c8 = matmul(a8, b8)
+cz = matmul(az, bz)
+w8 = matmul(a8, v8)
+!$omp end workshare
+!$omp end parallel
+
+result = 0
+expect = 0
+result(1) = count(c4 /= s4)
+result(2) = count(c8 /= s8)
+result(3) = count(cz /= sz)
+result(4) = count(w8 /= t8)
+call check(result, expect, NTESTS)
+end
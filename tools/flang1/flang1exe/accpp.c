@@ -14,6 +14,10 @@
 #include "error.h"
 #include "machar.h"
 #include "version.h"
+#if !defined(HOST_WIN)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #define ACC_DBG                                                         \
   fprintf(stderr, "%d: toktyp=%c(%d);  tokval=%s; line=%d\n", __LINE__, \
@@ -256,6 +260,12 @@ static char ctable[256] = {
 #define D_WARNING 18
 
 static FILE *ifp;
+/* Regular input files are mapped into memory; iptr and iend bound the
+ * unread part of the current one.  iptr is NULL while reading with getc().
+ */
+static char *iptr, *iend;
+#define NEXTC() \
+  (iptr < iend ? (unsigned char)*iptr++ : iptr ? EOF : getc(ifp))
 
 /* record for #if stack */
 typedef struct {
@@ -285,6 +295,9 @@ typedef struct {
                         */
   LOGICAL from_stdinc; /* is a system header file */
   FILE *ifp;
+  char *map;     /* contents of ifp if mapped, else NULL */
+  size_t maplen; /* length of map */
+  char *iptr;    /* saved iptr while an included file is read */
 } INCLSTACK;
 
 #define F_PREDEF 1
@@ -645,6 +658,8 @@ static void add_predicate(char *);
 static ptrdiff_t realloc_linebuf(ptrdiff_t);
 static int nextok(char *, int);
 static int _nextline(void);
+static void map_input(void);
+static void close_input(void);
 static int mac_push(PPSYM *, char *);
 static void popstack(void);
 static void stash_paths(char *);
@@ -744,6 +759,7 @@ accpp(void)
   inclstack[0].count = 1;
   inclstack[0].from_stdinc = FALSE;
   ifp = inclstack[0].ifp;
+  map_input();
 
   linelen = LINELEN;
   linesize = (linelen + linelen);
@@ -1190,8 +1206,12 @@ accpp(void)
   if (iftop != 0)
     pperr(218, 3);
 
-  if (!flg.es)
-    (void)fseek(gbl.cppfil, 0L, 0);
+#if !defined(HOST_WIN)
+  /* gbl.srcfil itself stays open; only its mapping is released */
+  if (inclstack[0].map)
+    munmap(inclstack[0].map, inclstack[0].maplen);
+#endif
+  inclstack[0].map = NULL;
 
 /* -M option:  Print list of include files to stdout */
 /* -MD option:  Print list of include files to file <program>.d */
@@ -2107,13 +2127,16 @@ _doincl(char *name, int type, LOGICAL include_next)
 found:
   /* we need to increment the line # for this level */
   ++inclstack[inclev].lineno;
+  inclstack[inclev].iptr = iptr;
   ++inclev;
   if ((ifp = inclstack[inclev].ifp = fopen(fullname, "r")) == NULL) {
     --inclev; /* failed to open file so retract changes */
     --inclstack[inclev].lineno;
+    ifp = inclstack[inclev].ifp;
     error(2, 4, 0, fullname, CNULL);
     return;
   }
+  map_input();
 
   /* Test for recursive includes */
   for (i = 0; i < inclev - 1; i++) {
@@ -2184,13 +2207,16 @@ preincl(char *prename)
 
 found:
   /* we need to increment the line # for this level */
+  inclstack[inclev].iptr = iptr;
   ++inclev;
   if ((ifp = inclstack[inclev].ifp = fopen(fullname, "r")) == NULL) {
     --inclev; /* failed to open file so retract changes */
     --inclstack[inclev].lineno;
+    ifp = inclstack[inclev].ifp;
     error(2, 4, 0, fullname, CNULL);
     return;
   }
+  map_input();
 
   /* Test for recursive includes */
   for (i = 0; i < inclev - 1; i++) {
@@ -4676,7 +4702,6 @@ static int
 _nextline(void)
 {
   static int lastinc = 0;
-  FILE *fp;
   char *p;
   int i;
   int c;
@@ -4691,10 +4716,9 @@ _nextline(void)
   char *fn;
 
 again:
-  fp = ifp;
   lineptr = linebuf + linelen;
   startline = inclstack[inclev].lineno;
-  if ((c = getc(fp)) == EOF) {
+  if ((c = NEXTC()) == EOF) {
     if (inclev <= 0)
       return (EOF);
     fn = inclstack[inclev].fname;
@@ -4704,10 +4728,14 @@ again:
         break;
       }
     }
-    fclose(ifp);
+    close_input();
     --inclev;
       gbl.curr_file = inclstack[inclev].fname;
       ifp = inclstack[inclev].ifp;
+      iptr = inclstack[inclev].iptr;
+      iend = inclstack[inclev].map
+                 ? inclstack[inclev].map + inclstack[inclev].maplen
+                 : NULL;
       idir.last = inclstack[inclev].path_idx;
       strcpy(cur_fname, inclstack[inclev].fname);
       cur_from_stdinc = inclstack[inclev].from_stdinc;
@@ -4732,7 +4760,7 @@ joinlines:
       p += diff;
     }
     *p++ = c;
-    if ((c = getc(fp)) == '?')
+    if ((c = NEXTC()) == '?')
       isquest = 1;
     ++i;
   }
@@ -4776,12 +4804,60 @@ joinlines:
   if (dojoin) {
     firstime = 0;
     savestart = start;
-    c = getc(fp);
+    c = NEXTC();
     goto joinlines;
   }
   return *lineptr++;
 }
 
+/* Make the file just opened at inclstack[inclev] the current input.
+ * A regular file is mapped, starting from the current position of its
+ * stream; anything else is read with getc().
+ */
+static void
+map_input(void)
+{
+  INCLSTACK *is = &inclstack[inclev];
+#if !defined(HOST_WIN)
+  struct stat st;
+  long pos;
+  void *map;
+#endif
+
+  is->map = NULL;
+  is->maplen = 0;
+  iptr = iend = NULL;
+#if !defined(HOST_WIN)
+  if (fstat(fileno(is->ifp), &st) != 0 || !S_ISREG(st.st_mode) ||
+      st.st_size <= 0)
+    return;
+  pos = ftell(is->ifp);
+  if (pos < 0 || pos > st.st_size)
+    return;
+  map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(is->ifp), 0);
+  if (map == MAP_FAILED)
+    return;
+  is->map = map;
+  is->maplen = st.st_size;
+  iptr = is->map + pos;
+  iend = is->map + is->maplen;
+#endif
+}
+
+/* Release the file at inclstack[inclev] */
+static void
+close_input(void)
+{
+  INCLSTACK *is = &inclstack[inclev];
+
+#if !defined(HOST_WIN)
+  if (is->map)
+    munmap(is->map, is->maplen);
+#endif
+  is->map = NULL;
+  fclose(is->ifp);
+}
+
 static ptrdiff_t
 realloc_linebuf(ptrdiff_t extra)
 {
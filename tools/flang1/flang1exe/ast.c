@@ -32,6 +32,7 @@
 #include "rte.h"
 #include "extern.h"
 #include "rtlRtns.h"
+#include "hash.h"
 
 static int reduce_iadd(int, INT);
 static int reduce_i8add(int, int);
@@ -47,6 +48,15 @@ static void conversion_warning(void);
 
 static int atemps; /* temp counter for bounds' temporaries */
 
+/* Hash table statistics reported by dump_ast() */
+static struct hash_stats {
+  unsigned long lookups; /* searches of the table */
+  int grows;             /* times the table was enlarged */
+} ast_hash_stats, asd_hash_stats, shd_hash_stats;
+
+static void init_hash(int **, int *);
+static void rehash_asds(void);
+
 #define MIN_INT64(n) \
   (((n[0] & 0xffffffff) == 0x80000000) && ((n[1] & 0xffffffff) == 0))
 
@@ -69,11 +79,12 @@ ast_init(void)
 #if DEBUG
     assert(astb.stg_base, "ast_init: no room for AST", astb.stg_size, 4);
 #endif
+    STG_ALLOC_SIDECAR(astb, astb.hshval);
   } else {
     STG_RESET(astb);
   }
   STG_NEXT(astb); /* reserve ast index 1 to terminate ast_traverse() */
-  BZERO(astb.hshtb, int, HSHSZ + 1);
+  init_hash(&astb.hshtb, &astb.hshsz);
 
   if (astb.asd.stg_size <= 0) {
     astb.asd.stg_size = 200;
@@ -82,7 +93,8 @@ ast_init(void)
     assert(astb.asd.stg_base, "ast_init: no room for ASD", astb.asd.stg_size, 4);
 #endif
   }
-  BZERO(astb.asd.hash, int, 7);
+  init_hash(&astb.asd.hshtb, &astb.asd.hshsz);
+  astb.asd.hshcnt = 0;
   astb.asd.stg_base[0] = 0;
   astb.asd.stg_avail = 1;
 
@@ -94,6 +106,8 @@ ast_init(void)
 #endif
   } else
     BZERO(astb.shd.hash, int, 7);
+  init_hash(&astb.shd.hshtb, &astb.shd.hshsz);
+  astb.shd.hshcnt = 0;
   astb.shd.stg_base[0].lwb = 0;
   astb.shd.stg_base[0].upb = 0;
   astb.shd.stg_base[0].stride = 0;
@@ -235,16 +249,23 @@ void
 ast_fini(void)
 {
   if (astb.stg_base) {
+    STG_DELETE_SIDECAR(astb, astb.hshval);
     STG_DELETE(astb);
   }
+  FREE(astb.hshtb);
+  astb.hshsz = 0;
   if (astb.asd.stg_base) {
     FREE(astb.asd.stg_base);
     astb.asd.stg_avail = astb.asd.stg_size = 0;
   }
+  FREE(astb.asd.hshtb);
+  astb.asd.hshsz = 0;
   if (astb.shd.stg_base) {
     FREE(astb.shd.stg_base);
     astb.shd.stg_avail = astb.shd.stg_size = 0;
   }
+  FREE(astb.shd.hshtb);
+  astb.shd.hshsz = 0;
   if (astb.std.stg_base) {
     STG_DELETE(astb.std);
   }
@@ -274,10 +295,86 @@ new_node(int type)
   return nd;
 }
 
-#define ADD_NODE(nd, a, hashval)       \
-  (nd) = new_node(a);                  \
-  A_HSHLKP((nd), astb.hshtb[hashval]); \
-  astb.hshtb[hashval] = (nd)
+/* Allocate an empty table of HSHSZ buckets, or clear the one there is if
+ * it still has that size.
+ */
+static void
+init_hash(int **hshtb, int *hshsz)
+{
+  if (*hshsz != HSHSZ) {
+    FREE(*hshtb);
+    *hshsz = HSHSZ;
+    NEW(*hshtb, int, HSHSZ);
+    assert(*hshtb, "ast_init: no room for hash table", HSHSZ, ERR_Fatal);
+  }
+  BZERO(*hshtb, int, HSHSZ);
+}
+
+/* Replace *hshtb by an empty table with at least 'want' buckets */
+static void
+new_hash_size(int **hshtb, int *hshsz, int want)
+{
+  FREE(*hshtb);
+  while (*hshsz < want)
+    *hshsz *= 2;
+  NEW(*hshtb, int, *hshsz);
+  assert(*hshtb, "ast: no room for hash table", *hshsz, ERR_Fatal);
+  BZERO(*hshtb, int, *hshsz);
+}
+
+#define AST_BUCKET(hashval) astb.hshtb[(hashval) & (astb.hshsz - 1)]
+
+/* Double astb.hshtb until it has at least one bucket per AST.  Each node
+ * is rehashed from its value in the astb.hshval sidecar.
+ */
+static void
+grow_ast_hash(void)
+{
+  int *list;
+  int n, i, nd, oldsz;
+
+  NEW(list, int, astb.stg_avail);
+  n = 0;
+  for (i = 0; i < astb.hshsz; ++i) {
+    for (nd = astb.hshtb[i]; nd != 0; nd = A_HSHLKG(nd)) {
+      assert(n < (int)astb.stg_avail, "grow_ast_hash: hash chains too long", i,
+             ERR_Fatal);
+      list[n++] = nd;
+    }
+  }
+  oldsz = astb.hshsz;
+  new_hash_size(&astb.hshtb, &astb.hshsz, astb.stg_avail);
+  /* reinsert from the back so each chain keeps its order */
+  while (n > 0) {
+    nd = list[--n];
+    A_HSHLKP(nd, AST_BUCKET(astb.hshval.stg_base[nd]));
+    AST_BUCKET(astb.hshval.stg_base[nd]) = nd;
+  }
+  FREE(list);
+  ++ast_hash_stats.grows;
+#if DEBUG
+  if (DBGBIT(4, 512))
+    fprintf(gbl.dbgfil, "grow_ast_hash: %d buckets -> %d for %d ASTs\n",
+            oldsz, astb.hshsz, astb.stg_avail);
+#endif
+}
+
+/* Enter the new node nd in astb.hshtb.  The table grows once it holds
+ * more than two nodes per bucket.
+ */
+static void
+link_node(int nd, unsigned hashval)
+{
+  if ((int)astb.stg_avail > 2 * astb.hshsz)
+    grow_ast_hash();
+  astb.hshval.stg_base[nd] = hashval;
+  A_HSHLKP(nd, AST_BUCKET(hashval));
+  AST_BUCKET(hashval) = nd;
+}
+
+#define ADD_NODE(nd, a, hashval) \
+  (nd) = new_node(a);            \
+  link_node(nd, hashval)
 
 /* not used
 #define HSH_0(a) hash_val(a, -1, -1, -1, -1)
@@ -287,34 +384,30 @@ new_node(int type)
 #define HSH_3(a, o1, o2, o3) hash_val(a, o1, o2, o3, -1)
 #define HSH_4(a, o1, o2, o3, o4) hash_val(a, o1, o2, o3, o4)
 
-static INT
+static unsigned
 hash_val(int a, int hw3, int hw4, int hw5, int hw6)
 {
-  INT hashval;
+  hash_accu_t hacc = HASH_ACCU_INIT;
 
-  hashval = a;
-  if (hw3 > 0)
-    hashval ^= hw3 >> 4;
-  if (hw4 > 0)
-    hashval ^= hw4 << 8;
-  if (hw5 > 0)
-    hashval ^= hw5 >> 8;
-  if (hw6 > 0)
-    hashval ^= hw6 << 16;
-  hashval &= 0x7fffffff;
-  hashval %= HSHSZ;
-  return hashval;
+  ++ast_hash_stats.lookups;
+  HASH_ACCU_ADD(hacc, a);
+  HASH_ACCU_ADD(hacc, hw3);
+  HASH_ACCU_ADD(hacc, hw4);
+  HASH_ACCU_ADD(hacc, hw5);
+  HASH_ACCU_ADD(hacc, hw6);
+  HASH_ACCU_FINISH(hacc);
+  return HASH_ACCU_VALUE(hacc);
 }
 
 /* hash an ast with dtype & sptr (A_ID, A_CNST, A_LABEL) */
 static int
 hash_sym(int a, DTYPE dtype, int sptr)
 {
-  INT hashval;
+  unsigned hashval;
   int nd;
 
   hashval = HSH_2(a, dtype, sptr);
-  for (nd = astb.hshtb[hashval]; nd != 0; nd = A_HSHLKG(nd)) {
+  for (nd = AST_BUCKET(hashval); nd != 0; nd = A_HSHLKG(nd)) {
     if (a == A_TYPEG(nd) && dtype == A_DTYPEG(nd) && sptr == A_SPTRG(nd))
       return nd;
   }
@@ -329,11 +422,11 @@ hash_sym(int a, DTYPE dtype, int sptr)
 static int
 hash_unop(int a, DTYPE dtype, int lop, int optype)
 {
-  INT hashval;
+  unsigned hashval;
   int nd;
 
   hashval = HSH_3(a, dtype, lop, optype);
-  for (nd = astb.hshtb[hashval]; nd != 0; nd = A_HSHLKG(nd)) {
+  for (nd = AST_BUCKET(hashval); nd != 0; nd = A_HSHLKG(nd)) {
     if (a == A_TYPEG(nd) && dtype == A_DTYPEG(nd) && lop == A_LOPG(nd) &&
         optype == A_OPTYPEG(nd))
       return nd;
@@ -349,11 +442,11 @@ hash_unop(int a, DTYPE dtype, int lop, int optype)
 static int
 hash_binop(int a, DTYPE dtype, int lop, int optype, int rop)
 {
-  INT hashval;
+  unsigned hashval;
   int nd;
 
   hashval = HSH_4(a, dtype, lop, optype, rop);
-  for (nd = astb.hshtb[hashval]; nd != 0; nd = A_HSHLKG(nd)) {
+  for (nd = AST_BUCKET(hashval); nd != 0; nd = A_HSHLKG(nd)) {
     if (a == A_TYPEG(nd) && dtype == A_DTYPEG(nd) && lop == A_LOPG(nd) &&
         optype == A_OPTYPEG(nd) && rop == A_ROPG(nd))
       return nd;
@@ -370,11 +463,11 @@ hash_binop(int a, DTYPE dtype, int lop, int optype, int rop)
 static int
 hash_paren(int a, DTYPE dtype, int lop)
 {
-  INT hashval;
+  unsigned hashval;
   int nd;
 
   hashval = HSH_2(a, dtype, lop);
-  for (nd = astb.hshtb[hashval]; nd != 0; nd = A_HSHLKG(nd)) {
+  for (nd = AST_BUCKET(hashval); nd != 0; nd = A_HSHLKG(nd)) {
     if (a == A_TYPEG(nd) && dtype == A_DTYPEG(nd) && lop == A_LOPG(nd))
       return nd;
   }
@@ -388,11 +481,11 @@ hash_paren(int a, DTYPE dtype, int lop)
 static int
 hash_conv(int a, DTYPE dtype, int lop, int shd)
 {
-  INT hashval;
+  unsigned hashval;
   int nd;
 
   hashval = HSH_3(a, dtype, lop, shd);
-  for (nd = astb.hshtb[hashval]; nd != 0; nd = A_HSHLKG(nd)) {
+  for (nd = AST_BUCKET(hashval); nd != 0; nd = A_HSHLKG(nd)) {
     if (a == A_TYPEG(nd) && dtype == A_DTYPEG(nd) && lop == A_LOPG(nd) &&
         (!shd || shd == A_SHAPEG(nd)))
       return nd;
@@ -407,11 +500,11 @@ hash_conv(int a, DTYPE dtype, int lop, int shd)
 static int
 hash_subscr(int a, DTYPE dtype, int lop, int asd)
 {
-  INT hashval;
+  unsigned hashval;
   int nd;
 
   hashval = HSH_3(a, dtype, lop, asd);
-  for (nd = astb.hshtb[hashval]; nd != 0; nd = A_HSHLKG(nd)) {
+  for (nd = AST_BUCKET(hashval); nd != 0; nd = A_HSHLKG(nd)) {
     if (a == A_TYPEG(nd) && dtype == A_DTYPEG(nd) && lop == A_LOPG(nd) &&
         asd == A_ASDG(nd))
       return nd;
@@ -427,11 +520,11 @@ hash_subscr(int a, DTYPE dtype, int lop, int asd)
 static int
 hash_mem(int a, DTYPE dtype, int parent, int mem)
 {
-  INT hashval;
+  unsigned hashval;
   int nd;
 
   hashval = HSH_3(a, dtype, parent, mem);
-  for (nd = astb.hshtb[hashval]; nd != 0; nd = A_HSHLKG(nd)) {
+  for (nd = AST_BUCKET(hashval); nd != 0; nd = A_HSHLKG(nd)) {
     if (a == A_TYPEG(nd) && dtype == A_DTYPEG(nd) && parent == A_PARENTG(nd) &&
         mem == A_MEMG(nd))
       return nd;
@@ -447,11 +540,11 @@ hash_mem(int a, DTYPE dtype, int parent, int mem)
 static int
 hash_cmplxc(int a, DTYPE dtype, int lop, int rop)
 {
-  INT hashval;
+  unsigned hashval;
   int nd;
 
   hashval = HSH_3(a, dtype, lop, rop);
-  for (nd = astb.hshtb[hashval]; nd != 0; nd = A_HSHLKG(nd)) {
+  for (nd = AST_BUCKET(hashval); nd != 0; nd = A_HSHLKG(nd)) {
     if (a == A_TYPEG(nd) && dtype == A_DTYPEG(nd) && lop == A_LOPG(nd) &&
         rop == A_ROPG(nd))
       return nd;
@@ -467,11 +560,11 @@ hash_cmplxc(int a, DTYPE dtype, int lop, int rop)
 static int
 hash_triple(int a, int lb, int ub, int stride)
 {
-  INT hashval;
+  unsigned hashval;
   int nd;
 
   hashval = HSH_3(a, lb, ub, stride);
-  for (nd = astb.hshtb[hashval]; nd != 0; nd = A_HSHLKG(nd)) {
+  for (nd = AST_BUCKET(hashval); nd != 0; nd = A_HSHLKG(nd)) {
     if (a == A_TYPEG(nd) && lb == A_LBDG(nd) && ub == A_UPBDG(nd) &&
         stride == A_STRIDEG(nd))
       return nd;
@@ -487,11 +580,11 @@ hash_triple(int a, int lb, int ub, int stride)
 static int
 hash_substr(int a, DTYPE dtype, int lop, int left, int right)
 {
-  INT hashval;
+  unsigned hashval;
   int nd;
 
   hashval = HSH_4(a, dtype, lop, left, right);
-  for (nd = astb.hshtb[hashval]; nd != 0; nd = A_HSHLKG(nd)) {
+  for (nd = AST_BUCKET(hashval); nd != 0; nd = A_HSHLKG(nd)) {
     if (a == A_TYPEG(nd) && dtype == A_DTYPEG(nd) && lop == A_LOPG(nd) &&
         left == A_LEFTG(nd) && right == A_RIGHTG(nd))
       return nd;
@@ -1820,16 +1913,57 @@ mk_subscr_copy(int arr, int asd, DTYPE dtype)
   return ast;
 } /* mk_subscr_copy */
 
+static unsigned
+hash_asd(int *subs, int numdim)
+{
+  hash_accu_t hacc = HASH_ACCU_INIT;
+  int i;
+
+  HASH_ACCU_ADD(hacc, numdim);
+  for (i = 0; i < numdim; i++)
+    HASH_ACCU_ADD(hacc, subs[i]);
+  HASH_ACCU_FINISH(hacc);
+  return HASH_ACCU_VALUE(hacc);
+}
+
+#define ASD_BUCKET(hashval) astb.asd.hshtb[(hashval) & (astb.asd.hshsz - 1)]
+
+/* Rebuild astb.asd.hshtb from the ASDs in the table, with at least one
+ * bucket per ASD.  Later ASDs end up first in their chains, as if each
+ * had been entered by mk_asd().
+ */
+static void
+rehash_asds(void)
+{
+  int asd, numdim;
+  unsigned hashval;
+
+  new_hash_size(&astb.asd.hshtb, &astb.asd.hshsz, astb.asd.hshcnt);
+  astb.asd.hshcnt = 0;
+  for (asd = 1; asd < (int)astb.asd.stg_avail;
+       asd += sizeof(ASD) / sizeof(int) + numdim - 1) {
+    numdim = ASD_NDIM(asd);
+    hashval = hash_asd(&ASD_SUBS(asd, 0), numdim);
+    ASD_NEXT(asd) = ASD_BUCKET(hashval);
+    ASD_BUCKET(hashval) = asd;
+    ++astb.asd.hshcnt;
+  }
+}
+
 /* Find or create an ASD with these subscripts */
 int
 mk_asd(int *subs, int numdim)
 {
   int i;
   int asd;
+  unsigned hashval;
   assert(numdim > 0 && numdim <= MAXSUBS, "mk_subscr: bad numdim", numdim,
          ERR_Fatal);
-  /* search the existing ASDs with the same number of dimensions */
-  for (asd = astb.asd.hash[numdim - 1]; asd != 0; asd = ASD_NEXT(asd)) {
+  hashval = hash_asd(subs, numdim);
+  ++asd_hash_stats.lookups;
+  for (asd = ASD_BUCKET(hashval); asd != 0; asd = ASD_NEXT(asd)) {
+    if (ASD_NDIM(asd) != numdim)
+      continue;
     for (i = 0; i < numdim; i++) {
       if (subs[i] != ASD_SUBS(asd, i))
         goto next_asd;
@@ -1843,13 +1977,19 @@ mk_asd(int *subs, int numdim)
   astb.asd.stg_avail += sizeof(ASD) / sizeof(int) + numdim - 1;
   NEED(astb.asd.stg_avail, astb.asd.stg_base, int, astb.asd.stg_size, astb.asd.stg_avail + 240);
   ASD_NDIM(asd) = numdim;
-  ASD_NEXT(asd) = astb.asd.hash[numdim - 1];
-  astb.asd.hash[numdim - 1] = asd;
   for (i = 0; i < numdim; i++) {
     int sub = subs[i];
     assert(sub > 0, "mk_asd() bad subscript ast at dim", i + 1, ERR_Severe);
     ASD_SUBS(asd, i) = sub;
   }
+  if (++astb.asd.hshcnt > 2 * astb.asd.hshsz) {
+    /* this enters the new ASD as well */
+    rehash_asds();
+    ++asd_hash_stats.grows;
+  } else {
+    ASD_NEXT(asd) = ASD_BUCKET(hashval);
+    ASD_BUCKET(hashval) = asd;
+  }
   return asd;
 }
 
@@ -2152,12 +2292,54 @@ static struct {
   } spec[MAXRANK]; /* maximum number of dimensions */
 } _shd;
 
+static unsigned
+hash_shd(int ndim, int upb, int stride)
+{
+  hash_accu_t hacc = HASH_ACCU_INIT;
+
+  HASH_ACCU_ADD(hacc, ndim);
+  HASH_ACCU_ADD(hacc, upb);
+  HASH_ACCU_ADD(hacc, stride);
+  HASH_ACCU_FINISH(hacc);
+  return HASH_ACCU_VALUE(hacc);
+}
+
+/* An SHD is hashed on its rank and the upper bound and stride of its first
+ * dimension.  The lower bounds are left out because dpm_out.c resets them
+ * in place.
+ */
+#define SHD_BUCKET(hashval) astb.shd.hshtb[(hashval) & (astb.shd.hshsz - 1)]
+
+/** \brief Rebuild astb.shd.hshtb from the SHDs in the table.
+
+    This must be called after the upper bounds or strides of existing SHDs
+    are changed in place, so that mk_shape() finds them under their new
+    bounds.
+ */
+void
+rehash_shapes(void)
+{
+  int shape, ndim;
+  unsigned hashval;
+
+  new_hash_size(&astb.shd.hshtb, &astb.shd.hshsz, astb.shd.hshcnt);
+  astb.shd.hshcnt = 0;
+  for (shape = 1; shape < (int)astb.shd.stg_avail; shape += ndim + 1) {
+    ndim = SHD_NDIM(shape);
+    hashval = hash_shd(ndim, SHD_UPB(shape, 0), SHD_STRIDE(shape, 0));
+    SHD_HSHLK(shape) = SHD_BUCKET(hashval);
+    SHD_BUCKET(hashval) = shape;
+    ++astb.shd.hshcnt;
+  }
+}
+
 int
 mk_shape(void)
 {
   int ndim;
   int shape;
   int i;
+  unsigned hashval;
 
   ndim = _shd.ndim;
 #if DEBUG
@@ -2165,9 +2347,11 @@ mk_shape(void)
          _shd.ndim, 4);
 #endif
 
-  /* search the existing SHDs with the same number of dimensions
-   */
-  for (shape = astb.shd.hash[ndim - 1]; shape; shape = SHD_NEXT(shape)) {
+  hashval = hash_shd(ndim, _shd.spec[0].upb, _shd.spec[0].stride);
+  ++shd_hash_stats.lookups;
+  for (shape = SHD_BUCKET(hashval); shape; shape = SHD_HSHLK(shape)) {
+    if (SHD_NDIM(shape) != ndim)
+      continue;
     for (i = 0; i < ndim; i++)
       if (SHD_LWB(shape, i) != _shd.spec[i].lwb ||
           SHD_UPB(shape, i) != _shd.spec[i].upb ||
@@ -2186,13 +2370,20 @@ mk_shape(void)
   NEED(astb.shd.stg_avail, astb.shd.stg_base, SHD, astb.shd.stg_size, astb.shd.stg_avail + 240);
   SHD_NDIM(shape) = ndim;
   SHD_NEXT(shape) = astb.shd.hash[ndim - 1];
-  SHD_FILL(shape) = 0; /* avoid bogus UMR reports */
   astb.shd.hash[ndim - 1] = shape;
   for (i = 0; i < ndim; i++) {
     SHD_LWB(shape, i) = _shd.spec[i].lwb;
     SHD_UPB(shape, i) = _shd.spec[i].upb;
     SHD_STRIDE(shape, i) = _shd.spec[i].stride;
   }
+  if (++astb.shd.hshcnt > 2 * astb.shd.hshsz) {
+    /* this enters the new SHD as well */
+    rehash_shapes();
+    ++shd_hash_stats.grows;
+  } else {
+    SHD_HSHLK(shape) = SHD_BUCKET(hashval);
+    SHD_BUCKET(hashval) = shape;
+  }
 
 found:
   return shape;
@@ -6917,6 +7108,47 @@ dump_ast_tree(int i)
   }
 }
 
+static int
+ast_hshlk(int nd)
+{
+  return A_HSHLKG(nd);
+}
+
+static int
+asd_hshlk(int asd)
+{
+  return ASD_NEXT(asd);
+}
+
+static int
+shd_hshlk(int shape)
+{
+  return SHD_HSHLK(shape);
+}
+
+static void
+dump_hash_stats(const char *what, int *hshtb, int hshsz, int (*link)(int),
+                struct hash_stats *stats)
+{
+  int i, nd, len, used, longest, entries;
+
+  used = longest = entries = 0;
+  for (i = 0; i < hshsz; i++) {
+    len = 0;
+    for (nd = hshtb[i]; nd != 0; nd = link(nd))
+      ++len;
+    if (len)
+      ++used;
+    if (len > longest)
+      longest = len;
+    entries += len;
+  }
+  fprintf(gbl.dbgfil,
+          "%s hash: %d entries, %d buckets, %d used, longest chain %d, "
+          "%lu lookups, %d grows\n",
+          what, entries, hshsz, used, longest, stats->lookups, stats->grows);
+}
+
 /* routine must be externally visible */
 void
 dump_ast(void)
@@ -6932,9 +7164,14 @@ dump_ast(void)
   fprintf(gbl.dbgfil, "\n");
   if (DBGBIT(4, 512)) {
     fprintf(gbl.dbgfil, "HashIndex  First\n");
-    for (i = 0; i <= HSHSZ; i++)
+    for (i = 0; i < astb.hshsz; i++)
       if (astb.hshtb[i])
         fprintf(gbl.dbgfil, "  %5d    %5d\n", i, (int)astb.hshtb[i]);
+    dump_hash_stats("AST", astb.hshtb, astb.hshsz, ast_hshlk, &ast_hash_stats);
+    dump_hash_stats("ASD", astb.asd.hshtb, astb.asd.hshsz, asd_hshlk,
+                    &asd_hash_stats);
+    dump_hash_stats("SHD", astb.shd.hshtb, astb.shd.hshsz, shd_hshlk,
+                    &shd_hash_stats);
   }
 }
 
@@ -7313,23 +7550,36 @@ void rw_ast_state(RW_ROUTINE, RW_FILE)
 {
   int nw;
 
-  RW_FD(astb.hshtb, astb.hshtb, 1);
+  nw = astb.hshsz;
+  RW_SCALAR(astb.hshsz);
+  if (ISREAD() && astb.hshsz != nw) {
+    FREE(astb.hshtb);
+    NEW(astb.hshtb, int, astb.hshsz);
+  }
+  RW_FD(astb.hshtb, int, astb.hshsz);
   RW_SCALAR(astb.stg_avail);
   RW_SCALAR(astb.stg_cleared);
   RW_SCALAR(astb.stg_dtsize);
   RW_FD(astb.stg_base, AST, astb.stg_avail);
+  RW_FD(astb.hshval.stg_base, unsigned int, astb.stg_avail);
 
-  RW_FD(astb.asd.hash, astb.asd.hash, 1);
+  /* the ASD and SHD hash tables are rebuilt from the entries below */
+  RW_SCALAR(astb.asd.hshcnt);
   RW_SCALAR(astb.asd.stg_avail);
   RW_SCALAR(astb.asd.stg_cleared);
   RW_SCALAR(astb.asd.stg_dtsize);
   RW_FD(astb.asd.stg_base, int, astb.asd.stg_avail);
 
   RW_FD(astb.shd.hash, astb.shd.hash, 1);
+  RW_SCALAR(astb.shd.hshcnt);
   RW_SCALAR(astb.shd.stg_avail);
   RW_SCALAR(astb.shd.stg_cleared);
   RW_SCALAR(astb.shd.stg_dtsize);
   RW_FD(astb.shd.stg_base, SHD, astb.shd.stg_avail);
+  if (ISREAD()) {
+    rehash_asds();
+    rehash_shapes();
+  }
 
   RW_SCALAR(astb.astli.stg_avail);
   RW_SCALAR(astb.astli.stg_cleared);
@@ -41,6 +41,8 @@ static LOGICAL same_forall_bnds(int, int, int);
 static LOGICAL is_fusable(int, int, int);
 static LOGICAL smp_conflict(int, int);
 static LOGICAL is_in_block(int, int);
+static int skip_to_forall(int, int);
+static LOGICAL has_indirection(int);
 static LOGICAL is_different_scalar_mask(int, int);
 static LOGICAL Conflict(int, int, int, LOGICAL, int, int);
 static LOGICAL is_branch_between(int, int);
@@ -964,7 +966,8 @@ is_olap_conflict(int forall, int forall1)
    </pre>
 
    The back end recognizes loops with 0 RHS and transforms these into calls
-   to _mzero, so don't fuse assignments with just 0 on the RHS.
+   to _mzero, so don't fuse assignments with just 0 on the RHS, except
+   to compiler temps, which may then be contracted to scalars.
  */
 static LOGICAL
 is_fusable(int lp, int lp1, int nested)
@@ -1035,7 +1038,8 @@ is_fusable(int lp, int lp1, int nested)
 
   if (A_TYPEG(rhs) == A_CONV)
     rhs = A_LOPG(rhs);
-  if (flg.opt >= 2 && !fuse_cnst_rhs && A_TYPEG(rhs) == A_CNST) {
+  if (flg.opt >= 2 && !fuse_cnst_rhs && A_TYPEG(rhs) == A_CNST &&
+      !HCCSYMG(lhs_sptr)) {
     /*
      * prefer calling a tuned mzero/mem rather fusing.
      */
@@ -1062,7 +1066,8 @@ is_fusable(int lp, int lp1, int nested)
   lhs_sptr1 = sym_of_ast(lhs1);
   if (A_TYPEG(rhs1) == A_CONV)
     rhs1 = A_LOPG(rhs1);
-  if (flg.opt >= 2 && !fuse_cnst_rhs && A_TYPEG(rhs1) == A_CNST) {
+  if (flg.opt >= 2 && !fuse_cnst_rhs && A_TYPEG(rhs1) == A_CNST &&
+      !HCCSYMG(lhs_sptr1)) {
     /*
      * prefer calling a tuned mzero/mem rather fusing.
      */
@@ -1121,9 +1126,10 @@ is_fusable(int lp, int lp1, int nested)
   }
 
   /* because of using mask pghpf_vsub_gather	*/
-  /* this can be optimized, iff expr1 and rhs1
-   * does not have indirections */
-  if (A_TYPEG(lhs_array) == A_SUBSCR && contains_ast(expr1, A_LOPG(lhs_array)))
+  /* this is only needed if expr1 or rhs1 has indirections */
+  if (A_TYPEG(lhs_array) == A_SUBSCR &&
+      contains_ast(expr1, A_LOPG(lhs_array)) &&
+      (has_indirection(expr1) || has_indirection(rhs1)))
     return FALSE;
 
   if (expr1)
@@ -1270,20 +1276,63 @@ is_in_block(int std, int std1)
   assert(nd, "is_in_block: nd is 0", forallh, 3);
   for (k = 0; k < FT_NFUSE(nd, 0); k++) {
     fusedstd = FT_FUSEDSTD(nd, 0, k);
-    nextstd = STD_NEXT(header);
-    while (A_TYPEG(STD_AST(nextstd)) == A_CONTINUE)
-      nextstd = STD_NEXT(nextstd);
+    nextstd = skip_to_forall(STD_NEXT(header), STD_AST(fusedstd));
     header = nextstd;
     if (nextstd == fusedstd)
       continue;
     return FALSE;
   }
-  nextstd = STD_NEXT(header);
-  while (A_TYPEG(STD_AST(nextstd)) == A_CONTINUE)
-    nextstd = STD_NEXT(nextstd);
+  nextstd = skip_to_forall(STD_NEXT(header), forall1);
   return (nextstd == std1);
 }
 
+/*
+ * Skip the statements from std on that cannot affect forall: CONTINUEs,
+ * comments, and deallocations of compiler temps that forall doesn't use.
+ */
+static int
+skip_to_forall(int std, int forall)
+{
+  int ast;
+
+  for (; std; std = STD_NEXT(std)) {
+    ast = STD_AST(std);
+    if (A_TYPEG(ast) == A_CONTINUE || A_TYPEG(ast) == A_COMMENT)
+      continue;
+    if (A_TYPEG(ast) == A_ALLOC && A_TKNG(ast) == TK_DEALLOCATE &&
+        A_TYPEG(A_SRCG(ast)) == A_ID && HCCSYMG(A_SPTRG(A_SRCG(ast))) &&
+        !contains_ast(forall, A_SRCG(ast)))
+      continue;
+    break;
+  }
+  return std;
+}
+
+/* This is the callback function for has_indirection(). */
+static LOGICAL
+_has_indirection(int ast, LOGICAL *pflag)
+{
+  if (A_TYPEG(ast) == A_SUBSCR && is_indirection_in_it(ast)) {
+    *pflag = TRUE;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+/* Does expression ast subscript an array with an array-valued subscript? */
+static LOGICAL
+has_indirection(int ast)
+{
+  LOGICAL result = FALSE;
+
+  if (!ast)
+    return FALSE;
+  ast_visit(1, 1);
+  ast_traverse(ast, _has_indirection, NULL, &result);
+  ast_unvisit();
+  return result;
+}
+
 static LOGICAL
 is_branch_between(int lp, int lp1)
 {
@@ -3380,6 +3429,8 @@ rewrite_all_shape(LITEMF *exceptions)
       }
     }
   }
+  /* the rewritten bounds change where mk_shape() looks for each shape */
+  rehash_shapes();
 }
 
 static void
@@ -725,9 +725,6 @@ fpp(void)
   if (iftop != 0)
     pperr(238, 3);
 
-  if (!flg.es)
-    (void)fseek(gbl.cppfil, 0L, 0);
-
   FREE(argbuf);
   FREE(deftab);
   FREE(hashrec);
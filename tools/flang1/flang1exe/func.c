@@ -3779,6 +3779,21 @@ rewrite_asn(int ast, int std, bool flag, int lc)
           goto rewrite_this; /* vector subscript */
     }
     /* Otherwise, we can use lhs directly */
+    if (A_TYPEG(rhs) == A_INTR && A_OPTYPEG(rhs) == I_MATMUL) {
+      /* a small matmul expands a transpose() argument in place, so try
+       * it before the arguments are computed into temps */
+      new_rhs = inline_reduction_f90(rhs, lhs, lc, &doremove);
+      if (A_TYPEG(new_rhs) != A_INTR) {
+        if (doremove) {
+          if (std)
+            delete_stmt(std);
+        } else {
+          A_SRCP(ast, new_rhs);
+        }
+        return;
+      }
+      rhs = new_rhs;
+    }
     args = rewrite_sub_args(rhs, lc);
     A_ARGSP(rhs, args);
     new_rhs = inline_reduction_f90(rhs, lhs, lc, &doremove);
@@ -5436,20 +5451,32 @@ build_array_ref(int inast, int si, int vi, int sj, int vj)
 
 } /* build_array_ref */
 
+/*
+ * A transpose() of an argument without calls is expanded in place by
+ * build_array_ref(), so it need not be computed into a temp first.
+ */
+static LOGICAL
+inline_transpose_arg(int arg)
+{
+  return A_TYPEG(arg) == A_INTR && A_OPTYPEG(arg) == I_TRANSPOSE &&
+         !contains_any_call(ARGT_ARG(A_ARGSG(arg), 0));
+}
+
 /*
  *  a = matmul( b, c )
- *  where the extent of a, b, c is less than 3 in each dimension
+ *  where the extent of a, b, c is at most 4 in each dimension
  *  inline to
  *   a(i,j) = sum(b(i,k) * c(k,j))
  *  where we expand i, j, k at compile time from 1 to the extent.
  *  for I_MATMUL_TRANSPOSE, we transpose the first argument:
  *   a(i,j) = sum(b(k,i) * c(k,j))
- *  if dest is zero, we have to create a temp array of the appropriate size
- *  and return a reference to that array.
+ *  if dest is zero or may overlap b or c, we have to create a temp array
+ *  of the appropriate size and return a reference to that array;
+ *  otherwise the elements are assigned to dest and *doremove is set.
  */
 
 static int
-inline_small_matmul(int ast, int dest)
+inline_small_matmul(int ast, int dest, LOGICAL *doremove)
 {
   ISZ_T ilow, ihigh, istride, iextent;
   ISZ_T jlow, jhigh, jstride, jextent;
@@ -5463,6 +5490,8 @@ inline_small_matmul(int ast, int dest)
   int subscr[MAXSUBS];
   int mulop, addop;
   int stdprev;
+  int eldtype;
+  LOGICAL uselhs;
   if (XBIT(47, 0x200))
     return ast;
   args = A_ARGSG(ast);
@@ -5473,13 +5502,13 @@ inline_small_matmul(int ast, int dest)
 
   stdprev = STD_PREV(arg_gbl.std);
   arg1 = rewrite_scalar_functions(arg1, arg_gbl.std);
-  if (contains_any_call(arg1)) {
+  if (contains_any_call(arg1) && !inline_transpose_arg(arg1)) {
     arg1 = rewrite_sub_ast(arg1, 0);
     if (arg1 == -1)
       return ast;
   }
   arg2 = rewrite_scalar_functions(arg2, arg_gbl.std);
-  if (contains_any_call(arg2)) {
+  if (contains_any_call(arg2) && !inline_transpose_arg(arg2)) {
     arg2 = rewrite_sub_ast(arg2, 0);
     if (arg2 == -1)
       return ast;
@@ -5584,17 +5613,20 @@ inline_small_matmul(int ast, int dest)
     return ast;
   if (kextent <= 0 || kextent > 4)
     return ast;
-  if (iextent * jextent * kextent > 32)
+  if (iextent * jextent * kextent > 64)
     return ast;
 
   array1 = convert_subscript_in_expr(arg1);
   array2 = convert_subscript_in_expr(arg2);
   stdnext = arg_gbl.std;
   lineno = STD_LINENO(stdnext);
-  if (1 || !dest) {
-    int sptr, dtnew, eldtype;
+  eldtype = DDTG(A_DTYPEG(ast));
+  /* with no dependence in the assignment, store the result directly */
+  uselhs = dest && dest == arg_gbl.lhs && !arg_gbl.used &&
+           matmul_use_lhs(dest, SHD_NDIM(A_SHAPEG(ast)), eldtype);
+  if (!uselhs) {
+    int sptr, dtnew;
     ADSC *ad;
-    eldtype = DDTG(A_DTYPEG(ast));
     if (SHD_NDIM(shape1) == 1) {
       dtnew = get_array_dtype(1, eldtype);
       ad = AD_DPTR(dtnew);
@@ -5666,6 +5698,11 @@ inline_small_matmul(int ast, int dest)
       STD_KERNEL(std) = STD_KERNEL(stdnext);
     }
   }
+  if (uselhs) {
+    arg_gbl.used = TRUE;
+    if (doremove)
+      *doremove = TRUE;
+  }
   /* return the destination array */
   return arraydest;
 } /* inline_small_matmul */
@@ -5760,7 +5797,7 @@ inline_reduction_f90(int ast, int dest, int lc, LOGICAL *doremove)
   case I_MATMUL_TRANSPOSE:
     if (doremove)
       *doremove = FALSE;
-    return inline_small_matmul(ast, dest);
+    return inline_small_matmul(ast, dest, doremove);
   default:
     return ast;
   }
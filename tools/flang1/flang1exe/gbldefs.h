@@ -201,6 +201,7 @@ void dump_ast_tree(int i); /* ast.c */
 void dumpaccrout(void); /* accroutine.c */
 
 void reportarea(int full);            /* salloc.c */
+void areausage(size_t *held, size_t *hiwater); /* salloc.c */
 void lower_ipa_info(FILE *lowerfile); /* ipa.c */
 
 void ipa_init(void);              /* ipa.c */
@@ -2294,3 +2294,479 @@ make_arg_copy(int sptrEntry, int astCall, unsigned int arg)
     return FALSE;
   return A_TYPEG(astArg) == A_SUBSTR || !A_ISLVAL(A_TYPEG(astArg));
 }
+
+/* CONSTANT ARGUMENT SPECIALIZATION */
+
+/* Library routines commonly take their problem dimensions, flags, and kind
+ * selectors as arguments which are constants at every call site.  The
+ * constant integer arguments of each call are recorded by procedure name,
+ * and when a procedure called with constants earlier in the file is
+ * compiled, its body is versioned as
+ *   if (n .eq. 8 .and. k .eq. 1) then
+ *     <the body, with 8 for n and 1 for k>
+ *   else
+ *     <the body>
+ *   endif
+ * The guard makes each version correct whatever the caller, so calls from
+ * other files simply take the general version.
+ */
+#define MAX_CONST_ARGS 16   /* argument positions recorded per call */
+#define MAX_CONST_SETS 8    /* distinct sets of constants per procedure */
+#define MAX_SPEC_VERSIONS 2 /* specialized copies of a body */
+#define MAX_SPEC_STDS 200   /* statements in all of the specialized copies */
+
+typedef struct constset { /* constant arguments of one or more calls */
+  int mask;               /* argument positions which are constant */
+  ISZ_T val[MAX_CONST_ARGS];
+  int count; /* number of calls */
+} CS;
+
+typedef struct constentry { /* calls to one procedure */
+  char *sFunc;
+  char *sHost;
+  char *sMod;
+  int nargs;
+  int nsets;
+  CS sets[MAX_CONST_SETS];
+  struct constentry *pceNext;
+} CE;
+
+static CE *pceStart = NULL; /* procedures called with constants */
+
+static struct {
+  int sptr[MAX_CONST_ARGS]; /* specializable dummies, by position */
+  int nargs;
+  int used; /* dummies referenced in the body */
+  int defd; /* dummies possibly assigned in the body */
+} spec;
+
+/*
+ * Return the names of the module and host, or ".", of the procedure
+ * called as sptrCall, as the inline library names them.
+ */
+static void
+called_names(int sptrCall, const char **psMod, const char **psHost)
+{
+  int sptrMod, sptrHost;
+
+  if (!INTERNALG(sptrCall)) {
+    sptrHost = sptrCall;
+    *psHost = ".";
+  } else {
+    sptrHost = SCOPEG(sptrCall);
+    *psHost = SYMNAME(sptrHost);
+  }
+  *psMod = ".";
+  if (INMODULEG(sptrHost)) {
+    for (sptrMod = sptrHost; sptrMod > NOSYM; sptrMod = SCOPEG(sptrMod)) {
+      if (STYPEG(sptrMod) == ST_MODULE) {
+        *psMod = SYMNAME(sptrMod);
+        break;
+      }
+      if (SCOPEG(sptrMod) == sptrMod)
+        break;
+    }
+  }
+}
+
+static CE *
+find_constentry(const char *sMod, const char *sHost, const char *sFunc)
+{
+  CE *pce;
+
+  for (pce = pceStart; pce; pce = pce->pceNext)
+    if (!strcmp(pce->sFunc, sFunc) && !strcmp(pce->sHost, sHost) &&
+        !strcmp(pce->sMod, sMod))
+      return pce;
+  return NULL;
+}
+
+/* This is the callback function for record_const_args(). */
+static LOGICAL
+_record_const_call(int ast, int *unused)
+{
+  int sptrCall, argt, nargs, arg, cnst;
+  int mask, n, i;
+  ISZ_T val[MAX_CONST_ARGS];
+  const char *sMod, *sHost;
+  CE *pce;
+  CS *pcs;
+
+  if ((A_TYPEG(ast) != A_CALL && A_TYPEG(ast) != A_FUNC) ||
+      A_TYPEG(A_LOPG(ast)) != A_ID)
+    return FALSE;
+  sptrCall = A_SPTRG(A_LOPG(ast));
+  if (STYPEG(sptrCall) == ST_ALIAS)
+    sptrCall = SYMLKG(sptrCall);
+  if ((STYPEG(sptrCall) != ST_PROC && STYPEG(sptrCall) != ST_ENTRY) ||
+      HCCSYMG(sptrCall))
+    return FALSE;
+  argt = A_ARGSG(ast);
+  nargs = A_ARGCNTG(ast);
+  n = nargs < MAX_CONST_ARGS ? nargs : MAX_CONST_ARGS;
+  mask = 0;
+  for (i = 0; i < n; i++) {
+    arg = ARGT_ARG(argt, i);
+    if (arg && (cnst = A_ALIASG(arg)) && DT_ISINT(A_DTYPEG(cnst))) {
+      mask |= 1 << i;
+      val[i] = get_isz_cval(A_SPTRG(cnst));
+    } else {
+      val[i] = 0;
+    }
+  }
+  if (!mask)
+    return FALSE;
+
+  called_names(sptrCall, &sMod, &sHost);
+  pce = find_constentry(sMod, sHost, SYMNAME(sptrCall));
+  if (!pce) {
+    pce = (CE *)getitem(PERM_AREA, sizeof(CE));
+    pce->sFunc = STASH(SYMNAME(sptrCall), PERM_AREA);
+    pce->sHost = STASH(sHost, PERM_AREA);
+    pce->sMod = STASH(sMod, PERM_AREA);
+    pce->nargs = nargs;
+    pce->nsets = 0;
+    pce->pceNext = pceStart;
+    pceStart = pce;
+  }
+  if (pce->nargs != nargs)
+    return FALSE;
+  for (pcs = pce->sets; pcs < pce->sets + pce->nsets; pcs++) {
+    if (pcs->mask != mask)
+      continue;
+    for (i = 0; i < n; i++)
+      if (pcs->val[i] != val[i])
+        break;
+    if (i == n) {
+      pcs->count++;
+      return FALSE;
+    }
+  }
+  if (pce->nsets < MAX_CONST_SETS) {
+    pcs = &pce->sets[pce->nsets++];
+    pcs->mask = mask;
+    BCOPY(pcs->val, val, ISZ_T, n);
+    pcs->count = 1;
+  }
+  return FALSE;
+}
+
+/* Record the constant arguments of the calls in the current subprogram. */
+static void
+record_const_args(void)
+{
+  int std;
+
+  ast_visit(1, 1);
+  for (std = STD_NEXT(0); std; std = STD_NEXT(std))
+    ast_traverse(STD_AST(std), _record_const_call, NULL, NULL);
+  ast_unvisit();
+}
+
+/* Return the mask of the dummy which ast names, or 0. */
+static int
+spec_mask(int ast)
+{
+  int i;
+
+  if (ast && A_TYPEG(ast) == A_ID) {
+    for (i = 0; i < spec.nargs; i++)
+      if (spec.sptr[i] == A_SPTRG(ast))
+        return 1 << i;
+  }
+  return 0;
+}
+
+/* This is the callback function for specializable_body(). */
+static LOGICAL
+_find_spec_refs(int ast, int *unused)
+{
+  int argt, i;
+
+  switch (A_TYPEG(ast)) {
+  case A_ID:
+    spec.used |= spec_mask(ast);
+    break;
+  case A_ASN:
+    spec.defd |= spec_mask(A_DESTG(ast));
+    break;
+  case A_DO:
+    spec.defd |= spec_mask(A_DOVARG(ast));
+    break;
+  case A_ALLOC:
+    spec.defd |= spec_mask(A_LOPG(ast)) | spec_mask(A_DESTG(ast));
+    break;
+  case A_CALL:
+  case A_ICALL:
+  case A_FUNC:
+    argt = A_ARGSG(ast);
+    for (i = 0; i < A_ARGCNTG(ast); i++)
+      spec.defd |= spec_mask(ARGT_ARG(argt, i));
+    break;
+  }
+  return FALSE;
+}
+
+static LOGICAL
+spec_stmt_ok(int ast)
+{
+  switch (A_TYPEG(ast)) {
+  case A_ASN:
+  case A_IFTHEN:
+  case A_ELSEIF:
+  case A_ELSE:
+  case A_ENDIF:
+  case A_GOTO:
+  case A_DO:
+  case A_DOWHILE:
+  case A_ENDDO:
+  case A_CONTINUE:
+  case A_COMMENT:
+  case A_CALL:
+  case A_ICALL:
+  case A_STOP:
+  case A_ALLOC:
+  case A_ELSEWHERE:
+  case A_ENDWHERE:
+    return TRUE;
+  case A_IF:
+  case A_WHERE:
+    return !A_IFSTMTG(ast) || (A_TYPEG(A_IFSTMTG(ast)) != A_IF &&
+                               A_TYPEG(A_IFSTMTG(ast)) != A_WHERE &&
+                               spec_stmt_ok(A_IFSTMTG(ast)));
+  default:
+    return FALSE;
+  }
+}
+
+/*
+ * Can the body stdfirst..stdlast be duplicated?  It may contain no labels,
+ * parallel or accelerator constructs, or FORALLs.  Return its size in
+ * statements, or 0, and set spec.used and spec.defd.
+ */
+static int
+specializable_body(int stdfirst, int stdlast)
+{
+  int std, ast, nstds;
+
+  nstds = 0;
+  spec.used = 0;
+  spec.defd = 0;
+  ast_visit(1, 1);
+  for (std = stdfirst; std != STD_NEXT(stdlast); std = STD_NEXT(std)) {
+    ast = STD_AST(std);
+    if (STD_LABEL(std) || STD_BLKSYM(std) || STD_PAR(std) || STD_TASK(std) ||
+        STD_ACCEL(std) || STD_KERNEL(std) || !spec_stmt_ok(ast) ||
+        (A_TYPEG(ast) == A_DO && A_DOLABG(ast))) {
+      nstds = 0;
+      break;
+    }
+    ast_traverse(ast, _find_spec_refs, NULL, NULL);
+    nstds++;
+  }
+  ast_unvisit();
+  return nstds;
+}
+
+static LOGICAL
+spec_dummy_candidate(int sptr)
+{
+  if (sptr <= NOSYM || STYPEG(sptr) != ST_VAR || SCG(sptr) != SC_DUMMY ||
+      !DT_ISINT(DTYPEG(sptr)))
+    return FALSE;
+  return !OPTARGG(sptr) && !POINTERG(sptr) && !ALLOCATTRG(sptr) &&
+         !TARGETG(sptr) && !VOLG(sptr);
+}
+
+/* This is the callback function for spec_copy_stmt(). */
+static void
+_copy_spec_call(int ast, int *unused)
+{
+  int newast, argt, newargt, i;
+
+  switch (A_TYPEG(ast)) {
+  case A_CALL:
+  case A_ICALL:
+  case A_FUNC:
+  case A_INTR:
+    /* the argument lists of calls are rewritten in place, so each copy
+     * needs its own */
+    argt = A_ARGSG(ast);
+    newargt = mk_argt(A_ARGCNTG(ast));
+    for (i = 0; i < A_ARGCNTG(ast); i++)
+      ARGT_ARG(newargt, i) = ast_rewrite(ARGT_ARG(argt, i));
+    newast = mk_duplicate_ast(ast);
+    A_VISITP(newast, 0);
+    A_REPLP(newast, 0);
+    A_LOPP(newast, ast_rewrite(A_LOPG(ast)));
+    A_ARGSP(newast, newargt);
+    ast_replace(ast, newast);
+    break;
+  }
+}
+
+/*
+ * Return a copy of statement ast with the dummies of set pcs replaced by
+ * their constants.
+ */
+static int
+spec_copy_stmt(int ast, CS *pcs)
+{
+  int newast, i;
+
+  ast_visit(1, 1);
+  for (i = 0; i < spec.nargs; i++)
+    if (pcs->mask & (1 << i))
+      ast_replace(mk_id(spec.sptr[i]),
+                  mk_isz_cval(pcs->val[i], DTYPEG(spec.sptr[i])));
+  ast_traverse(ast, NULL, _copy_spec_call, NULL);
+  newast = ast_rewrite(ast);
+  ast_unvisit();
+  /* duplicate after ast_unvisit(), which resets the copied VISIT field */
+  if (newast == ast)
+    newast = mk_duplicate_ast(ast);
+  if ((A_TYPEG(newast) == A_IF || A_TYPEG(newast) == A_WHERE) &&
+      A_IFSTMTG(newast) && A_IFSTMTG(newast) == A_IFSTMTG(ast))
+    A_IFSTMTP(newast, mk_duplicate_ast(A_IFSTMTG(ast)));
+  return newast;
+}
+
+/* Add ast before std, at the source position of orig. */
+static int
+add_spec_stmt_before(int ast, int std, int orig)
+{
+  int newstd;
+
+  newstd = add_stmt_before(ast, std);
+  STD_LINENO(newstd) = STD_LINENO(orig);
+  STD_FINDEX(newstd) = STD_FINDEX(orig);
+  return newstd;
+}
+
+/*
+ * Version the body of the current subprogram on the constant arguments
+ * recorded for it.
+ */
+static void
+specialize_body(void)
+{
+  const char *sMod, *sHost;
+  CE *pce;
+  CS cand[MAX_CONST_SETS], tmp;
+  CS *pcs;
+  int ncand, nver, nstds;
+  int stdfirst, stdlast, std, newstd, ast, cond, cmp;
+  int ok, mask, i, j, v;
+
+  if (gbl.arets || SYMLKG(gbl.currsub) > NOSYM || !gbl.exitstd ||
+      !STD_LABEL(gbl.exitstd) || A_TYPEG(STD_AST(gbl.exitstd)) != A_CONTINUE)
+    return;
+  if (gbl.internal <= 1 || gbl.outersub == 0)
+    sHost = ".";
+  else
+    sHost = SYMNAME(gbl.outersub);
+  sMod = gbl.currmod ? SYMNAME(gbl.currmod) : ".";
+  pce = find_constentry(sMod, sHost, SYMNAME(gbl.currsub));
+  if (!pce || pce->nargs != PARAMCTG(gbl.currsub))
+    return;
+
+  spec.nargs = pce->nargs < MAX_CONST_ARGS ? pce->nargs : MAX_CONST_ARGS;
+  for (i = 0; i < spec.nargs; i++)
+    spec.sptr[i] = aux.dpdsc_base[DPDSCG(gbl.currsub) + i];
+  stdfirst = STD_NEXT(ENTSTDG(gbl.currsub));
+  stdlast = STD_PREV(gbl.exitstd);
+  if (stdfirst == gbl.exitstd)
+    return;
+  nstds = specializable_body(stdfirst, stdlast);
+  if (nstds == 0)
+    return;
+
+  /* the dummies which may be replaced by constants */
+  ok = 0;
+  for (i = 0; i < spec.nargs; i++) {
+    if (!(spec.used & (1 << i)) || !spec_dummy_candidate(spec.sptr[i]))
+      continue;
+    if (INTENTG(spec.sptr[i]) == INTENT_IN ||
+        (!ASSNG(spec.sptr[i]) && !(spec.defd & (1 << i)) &&
+         gbl.internal != 1))
+      ok |= 1 << i;
+  }
+
+  /* calls whose constants differ only for other dummies share a version */
+  ncand = 0;
+  for (pcs = pce->sets; pcs < pce->sets + pce->nsets; pcs++) {
+    mask = pcs->mask & ok;
+    if (!mask)
+      continue;
+    for (j = 0; j < ncand; j++) {
+      if (cand[j].mask != mask)
+        continue;
+      for (i = 0; i < spec.nargs; i++)
+        if ((mask & (1 << i)) && cand[j].val[i] != pcs->val[i])
+          break;
+      if (i == spec.nargs)
+        break;
+    }
+    if (j < ncand) {
+      cand[j].count += pcs->count;
+    } else {
+      cand[ncand] = *pcs;
+      cand[ncand].mask = mask;
+      ncand++;
+    }
+  }
+  /* the most frequent first */
+  for (i = 1; i < ncand; i++)
+    for (j = i; j > 0 && cand[j].count > cand[j - 1].count; j--) {
+      tmp = cand[j];
+      cand[j] = cand[j - 1];
+      cand[j - 1] = tmp;
+    }
+  nver = MAX_SPEC_STDS / nstds;
+  if (nver > MAX_SPEC_VERSIONS)
+    nver = MAX_SPEC_VERSIONS;
+  if (nver > ncand)
+    nver = ncand;
+  if (nver == 0)
+    return;
+
+  for (v = 0; v < nver; v++) {
+    cond = 0;
+    for (i = 0; i < spec.nargs; i++) {
+      if (!(cand[v].mask & (1 << i)))
+        continue;
+      cmp = mk_binop(OP_EQ, mk_id(spec.sptr[i]),
+                     mk_isz_cval(cand[v].val[i], DTYPEG(spec.sptr[i])),
+                     DT_LOG);
+      cond = cond ? mk_binop(OP_LAND, cond, cmp, DT_LOG) : cmp;
+    }
+    ast = mk_stmt(v == 0 ? A_IFTHEN : A_ELSEIF, 0);
+    A_IFEXPRP(ast, cond);
+    add_spec_stmt_before(ast, stdfirst, stdfirst);
+    for (std = stdfirst; std != gbl.exitstd; std = STD_NEXT(std)) {
+      newstd = add_spec_stmt_before(spec_copy_stmt(STD_AST(std), &cand[v]),
+                                    stdfirst, std);
+      STD_FLAGS(newstd) = STD_FLAGS(std);
+    }
+    TRACE2("specialize_body: %s version %d\n", SYMNAME(gbl.currsub), v);
+  }
+  add_spec_stmt_before(mk_stmt(A_ELSE, 0), stdfirst, stdfirst);
+  add_spec_stmt_before(mk_stmt(A_ENDIF, 0), gbl.exitstd, stdlast);
+  ccff_info(MSGOPT, "INL053", gbl.findex, gbl.funcline,
+            "%function specialized for %n sets of constant arguments",
+            "function=%s", SYMNAME(gbl.currsub), "n=%d", nver, NULL);
+}
+
+/*
+ * Record the constant arguments of the calls in the current subprogram and
+ * specialize it on those recorded from calls to it.
+ */
+void
+specialize_const_args(void)
+{
+  record_const_args();
+  if (gbl.rutype == RU_SUBR || gbl.rutype == RU_FUNC)
+    specialize_body();
+}
+
+/* END OF CONSTANT ARGUMENT SPECIALIZATION */
@@ -16,3 +16,4 @@ extern int extractor_possible(void);
 extern void inline_add_lib(char *sDir);
 extern void inline_add_func(char *sFunc, int nSize);
 extern void inliner(void);
+extern void specialize_const_args(void);
@@ -36,6 +36,9 @@
 #include "symutl.h"
 #include "lower.h"
 #include "extern.h"
+#if !defined(HOST_WIN)
+#include <sys/stat.h>
+#endif
 
 /* true, if reading in a module file for a 'contained' subprogram. */
 static LOGICAL inmodulecontains = FALSE;
@@ -109,7 +112,6 @@ typedef struct {          /* info on data type read from encoded file */
   int ty;                 /* type of dtype, TY_PTR, etc.  */
   int new_id;             /* dtype number for this compilation */
   LOGICAL dtypeinstalled; /* set if dtype complete */
-  int hashnext;           /* in hash table linked list */
 } DITEM;
 
 typedef struct symitem {/* info on symbol read from encoded mod file */
@@ -126,7 +128,6 @@ typedef struct symitem {/* info on symbol read from encoded mod file */
   char name[MAXIDLEN + 1]; /* symbol name (only certain stypes) */
   char *strptr;            /* pointer to char string (constant) */
   struct symitem *next;
-  struct symitem *hashnext; /* next item from hash table */
   int socptr;               /* overlap region pointer */
   int shadowptr;            /* new shadow region pointer */
 } SYMITEM;
@@ -152,7 +153,6 @@ typedef struct {/* info on ast read from mod file */
   int type;     /* A_TYPE(ast) */
   AST a;        /* AST data */
   int new_ast, old_ast;
-  int link; /* link to next ast in hash table */
   int list, flags, shape;
 } ASTITEM;
 
@@ -232,11 +232,6 @@ static struct {  /* table of asts read from mod file   */
   int sz;
 } astz;
 
-/* hash size is 1024 entries = 2^10, so HASHMASK has 10 lower-order bits on */
-#define ASTZHASHSIZE 1024
-#define ASTZHASHMASK 0x03ff
-static int astzhash[ASTZHASHSIZE];
-
 static struct {/* table of stds read from file */
   STDITEM *base;
   int avl;
@@ -277,10 +272,17 @@ static SYMITEM *symbol_list; /* list of symbols read from mod file  */
 static ALNITEM *align_list;  /* list of align descrs read from mod file */
 static DSTITEM *dist_list;   /* list of dist descrs read from mod file */
 
-#define SYMHASHSIZE 521
-static SYMITEM *symhash[SYMHASHSIZE];
-#define DTHASHSIZE 521
-static int dthash[DTHASHSIZE];
+/* Directory of the symbols, data types, and asts read from the mod file,
+ * indexed by their numbers when the mod file was created.  The data type
+ * and ast entries are one more than the index into dtz and astz; zero
+ * entries were not read.
+ */
+static struct {
+  SYMITEM **sym;
+  int *dt;
+  int *ast;
+  int symsz, dtsz, astsz;
+} modidx;
 
 #define BUFF_LEN 4096
 static char *buff = NULL;
@@ -340,6 +342,100 @@ static void get_component_init(lzhandle *, char *, char *, int);
 
 struct imported_modules_struct imported_modules = {NULL, 0, 0, 0, 0};
 
+/* Module files read during this compilation.  Each program unit, and each
+ * of its parses, imports its modules afresh; keep the text of each file so
+ * that it is read once.  An entry is used only while the file's identity,
+ * size, and modification time are unchanged.
+ */
+typedef struct modfile {
+  char *name;
+  char *text;
+  size_t size;
+#if !defined(HOST_WIN)
+  struct stat st;
+#endif
+  struct modfile *next;
+} MODFILE;
+
+static MODFILE *modfile_cache = NULL;
+
+/* the nanosecond modification time; macOS names it st_mtimespec */
+#if defined(__APPLE__)
+#define MODFILE_MTIM(st) ((st).st_mtimespec)
+#else
+#define MODFILE_MTIM(st) ((st).st_mtim)
+#endif
+
+/** \brief Open a module file for reading, from the cache when possible. */
+FILE *
+open_module_file(const char *name)
+{
+#if !defined(HOST_WIN)
+  MODFILE *mf;
+  struct stat st;
+  FILE *fd;
+
+  if (stat(name, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)
+    return fopen(name, "r");
+  for (mf = modfile_cache; mf; mf = mf->next) {
+    if (strcmp(mf->name, name) == 0)
+      break;
+  }
+  if (mf && (mf->st.st_dev != st.st_dev || mf->st.st_ino != st.st_ino ||
+             mf->st.st_size != st.st_size ||
+             MODFILE_MTIM(mf->st).tv_sec != MODFILE_MTIM(st).tv_sec ||
+             MODFILE_MTIM(mf->st).tv_nsec != MODFILE_MTIM(st).tv_nsec)) {
+    /* the file changed; read it again */
+    FREE(mf->text);
+    mf->text = NULL;
+  }
+  if (mf == NULL) {
+    NEW(mf, MODFILE, 1);
+    BZERO(mf, MODFILE, 1);
+    NEW(mf->name, char, strlen(name) + 1);
+    strcpy(mf->name, name);
+    mf->next = modfile_cache;
+    modfile_cache = mf;
+  }
+  if (mf->text == NULL) {
+    fd = fopen(name, "r");
+    if (fd == NULL)
+      return NULL;
+    NEW(mf->text, char, st.st_size);
+    mf->size = fread(mf->text, 1, st.st_size, fd);
+    fclose(fd);
+    mf->st = st;
+    if (mf->size != (size_t)st.st_size) {
+      /* short read; don't trust the cached text */
+      FREE(mf->text);
+      mf->text = NULL;
+      return fopen(name, "r");
+    }
+  }
+  fd = fmemopen(mf->text, mf->size, "r");
+  if (fd != NULL)
+    return fd;
+#endif
+  return fopen(name, "r");
+} /* open_module_file */
+
+/** \brief Forget the cached module files; called when a module file is
+ * written. */
+void
+flush_module_file_cache(void)
+{
+  MODFILE *mf, *next;
+
+  for (mf = modfile_cache; mf; mf = next) {
+    next = mf->next;
+    if (mf->text)
+      FREE(mf->text);
+    FREE(mf->name);
+    FREE(mf);
+  }
+  modfile_cache = NULL;
+} /* flush_module_file_cache */
+
 /** \brief Initialize import of module symbols, etc. */
 void
 import_init(void)
@@ -1159,7 +1255,7 @@ do_nested_uses(WantPrivates wantPrivates)
     if (DBGBIT(0, 0x10000))
       fprintf(gbl.dbgfil, "Open nested module file: %s\n", il->fullfilename);
 #endif
-    fd = fopen(il->fullfilename, "r");
+    fd = open_module_file(il->fullfilename);
     if (fd == NULL) {
       error(4, 0, gbl.lineno, "Unable to open MODULE file", il->modulefilename);
       continue;
@@ -1220,7 +1316,7 @@ do_nested_uses(WantPrivates wantPrivates)
       if (DBGBIT(0, 0x10000))
         fprintf(gbl.dbgfil, "Do nested use: %s\n", il->fullfilename);
 #endif
-      fd = fopen(il->fullfilename, "r");
+      fd = open_module_file(il->fullfilename);
       if (fd == NULL)
         continue;
       module_sym = import_mk_newsym(il->modulename, ST_MODULE);
@@ -1777,65 +1873,55 @@ find_member_name(char *symname, int stype, int scopesym, int offset)
 
 static int module_base = 0; /* base symbol for modules */
 
-/* The following routines manage the symbol_list hash table.
+/* The following routines manage the directory of symbols and data types.
  * Note: Searching down the symbol_list is way way too expensive
  */
 static void
 inithash(void)
 {
-  int i;
-  for (i = 0; i < SYMHASHSIZE; ++i) {
-    symhash[i] = NULL;
-  }
-  for (i = 0; i < DTHASHSIZE; ++i) {
-    dthash[i] = 0;
-  }
+  if (modidx.sym == NULL) {
+    modidx.symsz = modidx.dtsz = modidx.astsz = 1024;
+    NEW(modidx.sym, SYMITEM *, modidx.symsz);
+    NEW(modidx.dt, int, modidx.dtsz);
+    NEW(modidx.ast, int, modidx.astsz);
+  }
+  BZERO(modidx.sym, SYMITEM *, modidx.symsz);
+  BZERO(modidx.dt, int, modidx.dtsz);
+  BZERO(modidx.ast, int, modidx.astsz);
 } /* inithash */
 
 static void
 inserthash(int sptr, SYMITEM *ps)
 {
-  int h;
-  h = sptr % SYMHASHSIZE;
-  ps->hashnext = symhash[h];
-  symhash[h] = ps;
+  if (sptr < 0)
+    return;
+  NEEDB(sptr + 1, modidx.sym, SYMITEM *, modidx.symsz, sptr + modidx.symsz);
+  modidx.sym[sptr] = ps;
 } /* inserthash */
 
 static SYMITEM *
 findhash(int sptr)
 {
-  int h;
-  SYMITEM *ps;
-  h = sptr % SYMHASHSIZE;
-  for (ps = symhash[h]; ps; ps = ps->hashnext) {
-    if (ps->sptr == sptr)
-      return ps;
-  }
-  return NULL;
+  if (sptr < 0 || sptr >= modidx.symsz)
+    return NULL;
+  return modidx.sym[sptr];
 } /* findhash */
 
 static void
 insertdthash(int old_dt, int d)
 {
-  int h;
-  h = old_dt % DTHASHSIZE;
-  dtz.base[d].hashnext = dthash[h];
-  dthash[h] = d + 1; /* offset hash links by one, since zero is legal */
+  if (old_dt < 0)
+    return;
+  NEEDB(old_dt + 1, modidx.dt, int, modidx.dtsz, old_dt + modidx.dtsz);
+  modidx.dt[old_dt] = d + 1; /* offset by one, since zero is legal */
 } /* insertdthash */
 
 static DITEM *
 finddthash(int old_dt)
 {
-  int h;
-  int d;
-  h = old_dt % SYMHASHSIZE;
-  for (d = dthash[h]; d; d = dtz.base[d - 1].hashnext) {
-    DITEM *pd;
-    pd = dtz.base + (d - 1);
-    if (pd->id == old_dt)
-      return pd;
-  }
-  return NULL;
+  if (old_dt < 0 || old_dt >= modidx.dtsz || modidx.dt[old_dt] == 0)
+    return NULL;
+  return dtz.base + (modidx.dt[old_dt] - 1);
 } /* finddthash */
 
 /*
@@ -1939,7 +2025,6 @@ import(lzhandle *fdlz, WantPrivates wantPrivates, int ivsn)
   char module_name[MAXIDLEN + 1], rename_name[MAXIDLEN + 1],
       idname[MAXIDLEN + 1], scope_name[MAXIDLEN + 1];
   int module_sym, scope_sym, rename_sym, offset, scope_stype;
-  int hash;
   int first_ast;
   int currrout = 0;
 
@@ -1967,7 +2052,6 @@ import(lzhandle *fdlz, WantPrivates wantPrivates, int ivsn)
   astz.sz = 64;
   NEW(astz.base, ASTITEM, astz.sz);
   astz.avl = 0;
-  BZERO(astzhash, int, ASTZHASHSIZE);
 
   stdz.sz = 64;
   NEW(stdz.base, STDITEM, stdz.sz);
@@ -2059,9 +2143,11 @@ import(lzhandle *fdlz, WantPrivates wantPrivates, int ivsn)
         sptr = getsymbol(idname);
         pa->a.w4 = sptr;
       }
-      hash = pa->old_ast & ASTZHASHMASK;
-      pa->link = astzhash[hash];
-      astzhash[hash] = astz.avl;
+      if (pa->old_ast >= 0) {
+        NEEDB(pa->old_ast + 1, modidx.ast, int, modidx.astsz,
+              pa->old_ast + modidx.astsz);
+        modidx.ast[pa->old_ast] = astz.avl;
+      }
       if (!first_ast) {
         if (astb.firstuast == 12 && pa->old_ast < 12) {
           /* older versions of the compiler reserved ASTs numbered
@@ -2749,6 +2835,7 @@ exit_loop:
   if (for_module) {
     /* install all simple constant symbols first */
     for (ps = symbol_list; ps != NULL; ps = ps->next) {
+      grow_sym_hash(stb.stg_avail);
       if (ps->stype == ST_CONST)
         import_constant(ps);
     }
@@ -2756,6 +2843,7 @@ exit_loop:
   }
   /* install all symbols */
   for (ps = symbol_list; ps != NULL; ps = ps->next) {
+    grow_sym_hash(stb.stg_avail);
     if (!for_module && ps->stype == ST_CONST) {
       import_constant(ps);
     } else if (ps->new_sptr == 0 && ps->sc >= 0) {
@@ -3296,6 +3384,33 @@ get_num(int radix)
   if (*currp == '\n')
     return 0;
   chp = currp;
+  /* fast path: a short, plain number in the given radix; nearly every
+   * token in a module file is one */
+  {
+    char *d = chp;
+    int neg = 0, digit;
+    if (*d == '-') {
+      neg = 1;
+      ++d;
+    }
+    for (; d - chp - neg < 15; ++d) {
+      if (*d >= '0' && *d <= '9')
+        digit = *d - '0';
+      else if (radix == 16 && *d >= 'a' && *d <= 'f')
+        digit = *d - 'a' + 10;
+      else if (radix == 16 && *d >= 'A' && *d <= 'F')
+        digit = *d - 'A' + 10;
+      else
+        break;
+      val = val * radix + digit;
+    }
+    if (d > chp + neg &&
+        (*d == ' ' || *d == '\n' || *d == '\0' || *d == ':')) {
+      currp = d;
+      return neg ? -val : val;
+    }
+    val = 0;
+  }
   while (*currp != ' ' && *currp != '\n' && *currp != '\0' && *currp != ':')
     currp++;
   /*
@@ -4820,14 +4935,9 @@ static int
 new_ast(int old_ast)
 {
   ASTITEM *pa;
-  int hash, s;
+  int s;
 
-  hash = old_ast & ASTZHASHMASK;
-  for (s = astzhash[hash]; s; s = pa->link) {
-    pa = astz.base + (s - 1);
-    if (pa->old_ast == old_ast)
-      break;
-  }
+  s = old_ast >= 0 && old_ast < modidx.astsz ? modidx.ast[old_ast] : 0;
   if (!s) {
     if (old_ast < BASEast) {
       return old_ast;
@@ -4836,6 +4946,7 @@ new_ast(int old_ast)
     interr("incomplete interface file, missing AST", old_ast, 3);
     error(4, 0, gbl.lineno, "incomplete IPA file, missing AST ", "");
   }
+  pa = astz.base + (s - 1);
   if (pa->new_ast)
     return pa->new_ast;
   return fill_ast(pa);
@@ -78,6 +78,8 @@ int get_module_file_name(char *modulename, char *filename, int len);
 typedef enum { INCLUDE_PRIVATES, EXCLUDE_PRIVATES } WantPrivates;
 
 void import_init(void);
+FILE *open_module_file(const char *);
+void flush_module_file_cache(void);
 int import_inline(FILE *, char *);
 int import_interproc(FILE *, char *, char *, char *);
 int import_static(FILE *, char *);
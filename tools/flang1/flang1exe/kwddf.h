@@ -18,14 +18,17 @@ typedef struct {
   KWORD *kwds; /* pointer to first in array of KWORD */
                /* the following members are filled in by init_ktable() to record
                 * the indices of the first and last keywords beginning with a
-                * certain letter.   If first[] is zero, there does not exist a
-                * keyword which begins with the respective letter.  A nonzero
-                * value is the index into the keyword table.
+                * certain pair of letters, and of the one-letter keywords.  If
+                * first[] or single[] is zero, there does not exist such a
+                * keyword.  A nonzero value is the index into the keyword table.
                 */
-  short first[26]; /* indexed by ('a' ... 'z') - 'a' */
-  short last[26];  /* indexed by ('a' ... 'z') - 'a' */
+  short single[26]; /* indexed by ('a' ... 'z') - 'a' */
+  short *first;     /* 26 * 26 entries, indexed by KT_PAIR() */
+  short *last;      /* 26 * 26 entries, indexed by KT_PAIR() */
 } KTABLE;
 
+#define KT_PAIR(c1, c2) ((c1) * 26 + (c2))
+
 /* NOTE:  When entering keywords in the tables, two or more consecutive tokens
  * that can be seen in the grammar should be combined into a single token.
  * This is because the keyword search routine is not designed to extract two
@@ -39,6 +39,10 @@ static char *contained_char = NULL;
 
 static int *outerflags = NULL;
 
+/* symbols of a host and its contained subprograms, buffered until the
+ * host's 'end' */
+static MEMFILE contained_file;
+
 #define STB_LOWER() ((gbl.outfil == lowersym.lowerfile) && gbl.stbfil)
 static void lower_directives_llvm(void);
 
@@ -147,7 +151,7 @@ lower(int staticinit)
     case 1:
       /* an outer subprogram that contains others */
       /* create a temporary file */
-      lowersym.lowerfile = tmpf("l");
+      lowersym.lowerfile = memf_open(&contained_file);
       if (lowersym.lowerfile == NULL) {
         error(0, 4, 0, "could not open temporary ILM symbol file", "");
       }
@@ -491,7 +495,10 @@ lower_end_contains(void)
     return;
   }
 
-  rewind(lowersym.lowerfile);
+  lowersym.lowerfile = memf_rewind(&contained_file);
+  if (lowersym.lowerfile == NULL) {
+    error(0, 4, 0, "could not reread temporary ILM symbol file", "");
+  }
   symbolslist = 1; /* 1 => reading symbols */
   outer = 1;
   while (fgets(buffer, LOWERBUFSIZ, lowersym.lowerfile) != NULL) {
@@ -593,7 +600,7 @@ lower_end_contains(void)
       }
     }
   }
-  fclose(lowersym.lowerfile);
+  memf_close(&contained_file);
   if (gbl.currmod)
     lowersym.lowerfile = gbl.outfil;
   else
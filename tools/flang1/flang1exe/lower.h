@@ -132,9 +132,30 @@
  *              pass elemental field for subprogram when emitting ST_ENTRY.
  *
  *              For ST_PROC, pass IS_PROC_PTR_IFACE flag.
+ *
+ *              -- 1.56
+ *              All of 1.55 +
+ *              ILM lines may be written as binary records, see ILM_BINARY.
  */
 #define VersionMajor 1
-#define VersionMinor 55
+#define VersionMinor 56
+
+/*
+ * An ILM line written as a binary record starts with ILM_BINARY and, like a
+ * text line, ends with a newline.  The operation follows as an ILM_VARINT:
+ * either the number of an operation named earlier in the routine, or zero
+ * followed by the length and characters of a new name, which gets the next
+ * number.  Each operand follows as its text letter (i, s, l, t or n) and its
+ * value as a zigzag-encoded ILM_VARINT.
+ *
+ * An ILM_VARINT is a sequence of bytes with 7 bits of the value, low bits
+ * first, and the high bit set, followed by a final byte of 0x40 plus the top 6
+ * bits.  No byte of a record is a newline or NUL, so records can be copied
+ * and read as lines.
+ */
+#define ILM_BINARY '\001'
+#define ILM_VARINT_LAST 0x40
+#define ILM_VARINT_MORE 0x80
 
 void lower(int);
 void lower_end_contains(void);
@@ -25,6 +25,7 @@
 #include "mp.h"
 #include "rte.h"
 #include "rtlRtns.h"
+#include "flang/ADT/hash.h"
 
 #define INSIDE_LOWER
 #include "lower.h"
@@ -33,6 +34,7 @@
 #endif
 
 static FILE *lower_ilm_file = NULL;
+static MEMFILE lower_ilm_buf;
 int lower_line;
 int lower_disable_ptr_chk = 0;
 int lower_disable_subscr_chk = 0;
@@ -61,17 +63,47 @@ extern void setrefsymbol(int symbol);
 #undef USE_LARGE_SIZE
 #define USE_LARGE_SIZE
 
+/* Write ILM lines as ILM_BINARY records rather than text */
+static int lower_ilm_binary;
+
+/* Operation names written to the binary records of this routine, and the
+ * numbers given them, starting at 1.
+ */
+static struct {
+  hashmap_t map;
+  char **names;
+  int size;
+  int avl;
+} lower_ilm_ops;
+
 void
 lower_ilm_header(void)
 {
+  int i;
+
   /* open the output file */
-  lower_ilm_file = tmpf("i");
+  lower_ilm_file = memf_open(&lower_ilm_buf);
   if (lower_ilm_file == NULL) {
     error(0, 4, 0, "could not open temporary ILM file", "");
   }
   fprintf(lower_ilm_file, "AST2ILM version %d/%d\n", VersionMajor,
           VersionMinor);
 
+  /* verbose ILM files are text, with comments */
+  lower_ilm_binary = !XBIT(50, 0x10) && !XBIT(50, 0x80);
+#if DEBUG
+  if (DBGBIT(47, 31) || DBGBIT(47, 8))
+    lower_ilm_binary = 0;
+#endif
+  if (lower_ilm_ops.map == NULL) {
+    lower_ilm_ops.map = hashmap_alloc(hash_functions_strings);
+    lower_ilm_ops.size = 64;
+    NEW(lower_ilm_ops.names, char *, lower_ilm_ops.size);
+  }
+  hashmap_clear(lower_ilm_ops.map);
+  for (i = 0; i < lower_ilm_ops.avl; ++i)
+    FREE(lower_ilm_ops.names[i]);
+  lower_ilm_ops.avl = 0;
 } /* lower_ilm_header */
 
 void
@@ -79,19 +111,72 @@ lower_ilm_finish(void)
 {
 #define LOWERBUFSIZ 10000
   char buffer[LOWERBUFSIZ];
-  int nw;
+  size_t nr;
   fprintf(lower_ilm_file, "end\n");
   /* append ilm file to sym file */
-  nw = fseek(lower_ilm_file, 0, SEEK_SET);
-  if (nw == -1)
-    perror("lower_ilm_finish - fseek on lower_ilm_file");
-  while (fgets(buffer, LOWERBUFSIZ, lower_ilm_file) != NULL) {
-    fputs(buffer, lowersym.lowerfile);
-  }
-  fclose(lower_ilm_file);
+  lower_ilm_file = memf_rewind(&lower_ilm_buf);
+  if (lower_ilm_file == NULL)
+    perror("lower_ilm_finish - rewind of lower_ilm_file");
+  else
+    while ((nr = fread(buffer, 1, LOWERBUFSIZ, lower_ilm_file)) > 0) {
+      fwrite(buffer, 1, nr, lowersym.lowerfile);
+    }
+  memf_close(&lower_ilm_buf);
   lower_ilm_file = NULL;
 } /* lower_ilm_finish */
 
+static void
+put_ilm_varint(unsigned val)
+{
+  while (val >= ILM_VARINT_LAST) {
+    putc(ILM_VARINT_MORE | (val & 0x7f), lower_ilm_file);
+    val >>= 7;
+  }
+  putc(ILM_VARINT_LAST | val, lower_ilm_file);
+} /* put_ilm_varint */
+
+/* Start an ILM line with operation op */
+static void
+put_ilm_operation(int opcount, char *op)
+{
+  hash_data_t data;
+  char *name;
+  int len;
+
+  if (!lower_ilm_binary) {
+    fprintf(lower_ilm_file, "i%d: %s", opcount, op);
+    return;
+  }
+  putc(ILM_BINARY, lower_ilm_file);
+  if (hashmap_lookup(lower_ilm_ops.map, op, &data)) {
+    put_ilm_varint(HKEY2INT(data));
+    return;
+  }
+  len = strlen(op);
+  NEW(name, char, len + 1);
+  strcpy(name, op);
+  NEED(lower_ilm_ops.avl + 1, lower_ilm_ops.names, char *, lower_ilm_ops.size,
+       lower_ilm_ops.size * 2);
+  lower_ilm_ops.names[lower_ilm_ops.avl++] = name;
+  hashmap_insert(lower_ilm_ops.map, name, INT2HKEY(lower_ilm_ops.avl));
+  put_ilm_varint(0);
+  put_ilm_varint(len);
+  fputs(name, lower_ilm_file);
+} /* put_ilm_operation */
+
+/* Add an operand with the given letter and value to the ILM line */
+static void
+put_ilm_operand(char letter, int val)
+{
+  if (!lower_ilm_binary) {
+    fprintf(lower_ilm_file, " %c%d", letter, val);
+    return;
+  }
+  putc(letter, lower_ilm_file);
+  /* zigzag: small negative values stay short */
+  put_ilm_varint(((unsigned)val << 1) ^ (unsigned)(val >> 31));
+} /* put_ilm_operand */
+
 static char saveoperation[50];
 
 static int plower_pdo(int, int);
@@ -139,7 +224,7 @@ plower(char *fmt, ...)
       pcount = -1;
     }
     opcount = ++pcount;
-    fprintf(lower_ilm_file, "i%d: %s", opcount, op);
+    put_ilm_operation(opcount, op);
     if (op[0] == '-' && op[1] == '-' && op[2] != '-') {
       lerror("unsupported %s", op);
     }
@@ -174,7 +259,7 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " i-%d", opcount - d);
       } else
 #endif
-        fprintf(lower_ilm_file, " i%d", d);
+        put_ilm_operand('i', d);
 #if DEBUG
       if (d <= 0 || d > pcount) {
         lerror("bad ilm link %d", d);
@@ -195,7 +280,7 @@ plower(char *fmt, ...)
         }
       } else
 #endif
-        fprintf(lower_ilm_file, " s%d", d);
+        put_ilm_operand('s', d);
 #if DEBUG
       if (d < 0 || d > stb.stg_avail) {
         lerror("bad sym link %d", d);
@@ -221,7 +306,7 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " %s", getprint(d));
       } else
 #endif
-        fprintf(lower_ilm_file, " s%d", d);
+        put_ilm_operand('s', d);
 #if DEBUG
       if (d <= 0 || d > stb.stg_avail) {
         lerror("bad sym link %d", d);
@@ -247,7 +332,7 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " s%d	;%s", d, getprint(d));
       } else
 #endif
-        fprintf(lower_ilm_file, " s%d", d);
+        put_ilm_operand('s', d);
 #if DEBUG
       if (d <= 0 || d > stb.stg_avail) {
         lerror("bad sym link %d", d);
@@ -270,7 +355,7 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " s%d	;%s", d, getprint(d));
       } else
 #endif
-        fprintf(lower_ilm_file, " s%d", d);
+        put_ilm_operand('s', d);
 #if DEBUG
       if (d <= 0 || d > stb.stg_avail) {
         lerror("bad sym link %d", d);
@@ -294,7 +379,7 @@ plower(char *fmt, ...)
       /* don't increment pcount */
       break;
     case 'l':
-      fprintf(lower_ilm_file, " l%d", d);
+      put_ilm_operand('l', d);
       ++pcount;
       break;
     case 'd':
@@ -314,7 +399,7 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " t%d", (int)DTY(d));
       } else
 #endif
-        fprintf(lower_ilm_file, " t%d", d);
+        put_ilm_operand('t', d);
       ++pcount;
       if (chf == 'd')
         lower_use_datatype(d, 1);
@@ -322,12 +407,12 @@ plower(char *fmt, ...)
         lower_use_datatype(d, 2);
       break;
     case 'n':
-      fprintf(lower_ilm_file, " n%d", d);
+      put_ilm_operand('n', d);
       ++pcount;
       break;
     case 'a':
     case 'A':
-      fprintf(lower_ilm_file, " i%d", d);
+      put_ilm_operand('i', d);
 #if DEBUG
       if (d <= 0 || d > pcount) {
         lerror("bad ilm link %d", d);
@@ -350,7 +435,7 @@ plower(char *fmt, ...)
         fprintf(lower_ilm_file, " t%d", (int)DTY(d));
       } else
 #endif
-        fprintf(lower_ilm_file, " t%d", d);
+        put_ilm_operand('t', d);
       ++pcount;
       break;
     }
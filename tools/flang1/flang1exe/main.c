@@ -15,6 +15,9 @@
 #if !defined(TARGET_WIN)
 #include <unistd.h>
 #endif
+#if defined(__GLIBC__)
+#include <stdio_ext.h>
+#endif
 #include <time.h>
 #include "global.h"
 #include "symtab.h"
@@ -29,6 +32,7 @@
 #include "lower.h"
 #include "dbg_out.h"
 #include "ccffinfo.h"
+#include "phasestat.h"
 #include "x86.h"
 #include "direct.h"
 #include "optimize.h"
@@ -48,6 +52,7 @@
 /* static prototypes */
 
 static void reptime(void);
+static void record_phase(const char *phase);
 static void add_debuglist(char *phasearg, char *dumparg);
 static void do_debug(char *phase);
 static void cleanup(void);
@@ -62,6 +67,9 @@ static void set_debug_line(LOGICAL value);
 static void do_set_tp(char *tp);
 static void fini(void);
 static void mkDwfInfoFilename(void);
+static FILE *open_cpp_output(void);
+static void scan_cpp_output(void);
+static void free_cpp_output(void);
 
 /* ******************************************************************** */
 
@@ -83,6 +91,12 @@ static char *who[] = {"init",     "parser",   "bblock", "vectorize", "optimize",
 #define _N_WHO (sizeof(who) / sizeof(char *))
 static INT xtimes[_N_WHO];
 static LOGICAL postprocessing = TRUE;
+static char *phasestat_file = NULL;
+#if !defined(HOST_WIN)
+/* preprocessed source, written by fpp() and read back by the scanner */
+static char *cpp_buf;
+static size_t cpp_len;
+#endif
 
 /* Feature names for Fortran front-end */
 #if defined(TARGET_LINUX_X8664)
@@ -133,7 +147,7 @@ static int dodebug = 0;
 #else
 #define TR(str)
 #define TR1(str)
-#define DUMP(a)
+#define DUMP(a) record_phase(a)
 #endif /* DEBUG */
 
 #define NO_FLEXLM
@@ -150,6 +164,7 @@ main(int argc, char *argv[])
   init(argc, argv); /* initialize */
   if (gbl.fn == NULL)
     gbl.fn = gbl.src_file;
+  phasestat_init(phasestat_file, "flang1", gbl.fn);
 
 #if DEBUG
   if (debugfunconly > 0)
@@ -199,6 +214,7 @@ main(int argc, char *argv[])
       ipa_export_highpoint();
     }
     xtimes[0] += get_rutime();
+    record_phase("init");
     if (ipa_export_file && ipa_import_mode) {
       ipa_import();
       if (gbl.eof_flag & 2)
@@ -318,6 +334,12 @@ main(int argc, char *argv[])
           DUMP("optalloc");
           TR1("- after optimize_alloc");
         }
+        if (flg.opt >= 2 && !XBIT(47, 0x800)) {
+          TR(DNAME " SPECIALIZE_CONST_ARGS begins\n");
+          specialize_const_args();
+          DUMP("specialize");
+          TR1("- after specialize_const_args");
+        }
 
         if (IPA_ENABLED) {
           ipasave();
@@ -512,6 +534,7 @@ main(int argc, char *argv[])
     if (flg.xref) {
       xref(); /* write cross reference map */
       xtimes[7] += get_rutime();
+      record_phase("xref");
     }
     skip_compile:
     (void)summary(FALSE, FALSE);
@@ -751,6 +774,7 @@ init(int argc, char *argv[])
   register_string_arg(arg_parser, "modexport", &modexport_val, NULL);
   register_string_arg(arg_parser, "modindex", &modindex_val, NULL);
   register_string_arg(arg_parser, "qfile", &dbgfile, NULL);
+  register_string_arg(arg_parser, "phasestats", &phasestat_file, NULL);
 
   /* Optimization level */
   register_integer_arg(arg_parser, "opt", &(flg.opt), 1);
@@ -1120,7 +1144,7 @@ init(int argc, char *argv[])
       unlink(gbl.ipaname);
     }
 
-    /* create temporary file for preprocessor output & preprocess */
+    /* open the stream for preprocessor output & preprocess */
     if (!ipa_import_mode) {
       if (fpp_) {
         if (flg.es) {
@@ -1129,7 +1153,7 @@ init(int argc, char *argv[])
           else if ((gbl.cppfil = fopen(cppfile, "w")) == NULL)
             errfatal(5);
         } else {
-          if ((gbl.cppfil = tmpf("a")) == NULL)
+          if ((gbl.cppfil = open_cpp_output()) == NULL)
             errfatal(5);
         }
         fpp();
@@ -1137,7 +1161,7 @@ init(int argc, char *argv[])
           finish();
         if (flg.list)
           list_page();
-        scan_init(gbl.cppfil);
+        scan_cpp_output();
       } else
         scan_init(gbl.srcfil);
     }
@@ -1183,6 +1207,7 @@ moddir_list *module_directory_list = NULL;
 static void
 do_debug(char *phase)
 {
+  record_phase(phase);
   if (debugfunconly > 0 && gbl.func_count != debugfunconly) {
     /* only for some functions */
     return;
@@ -1266,6 +1291,30 @@ reptime(void)
   fprintf(stderr, "%s\n", buf);
 }
 
+/** \brief Append the statistics for a phase that has just finished to the
+    -phasestats file.
+ */
+static void
+record_phase(const char *phase)
+{
+  int sptr;
+
+  if (!phasestat_enabled())
+    return;
+  phasestat_table("sym", stb.stg_avail);
+  phasestat_table("dt", stb.dt.stg_avail);
+  phasestat_table("ast", astb.stg_avail);
+  phasestat_table("std", astb.std.stg_avail);
+  phasestat_table("asd", astb.asd.stg_avail);
+  phasestat_table("shd", astb.shd.stg_avail);
+  phasestat_table("astli", astb.astli.stg_avail);
+  phasestat_table("argt", astb.argt.stg_avail);
+  sptr = gbl.currsub;
+  if (sptr == 0 && gbl.rutype == RU_BDATA)
+    sptr = gbl.currmod; /* a module */
+  phasestat_record(phase, sptr ? SYMNAME(sptr) : NULL);
+}
+
 static void
 datastructure_reinit(void)
 {
@@ -1350,6 +1399,53 @@ set_exitcode(int ec)
   exitcode = ec;
 }
 
+/* Create the stream that fpp() writes the preprocessed source to.  Where
+ * the host has memory streams the output stays in cpp_buf, so the scanner
+ * does not have to read it back from a temporary file.
+ */
+static FILE *
+open_cpp_output(void)
+{
+#if !defined(HOST_WIN)
+  FILE *fp = open_memstream(&cpp_buf, &cpp_len);
+#if defined(__GLIBC__)
+  /* memory streams are locked on every putc() otherwise */
+  if (fp != NULL)
+    __fsetlocking(fp, FSETLOCKING_BYCALLER);
+#endif
+  return fp;
+#else
+  return tmpf("a");
+#endif
+}
+
+/* Start the scanner on the preprocessed source */
+static void
+scan_cpp_output(void)
+{
+#if !defined(HOST_WIN)
+  /* closing the memory stream leaves its contents in cpp_buf */
+  fclose(gbl.cppfil);
+  gbl.cppfil = NULL;
+  scan_init_buffer(cpp_buf, cpp_len);
+#else
+  (void)fseek(gbl.cppfil, 0L, 0);
+  scan_init(gbl.cppfil);
+#endif
+}
+
+/* Release the preprocessed source once the scanner is finished with it */
+static void
+free_cpp_output(void)
+{
+#if !defined(HOST_WIN)
+  /* cpp_buf was allocated by open_memstream(), not by sccalloc() */
+  free(cpp_buf);
+  cpp_buf = NULL;
+  cpp_len = 0;
+#endif
+}
+
 /** \brief Write summary line to terminal, and exit compiler.
 */
 void
@@ -1360,6 +1456,7 @@ finish(void)
 
   if (!ipa_import_mode)
     scan_fini();
+  free_cpp_output();
   if (IPA_INHERIT_ENABLED && (flg.opt >= 2 || IPA_COLLECTION_ENABLED)) {
     ipa_fini();
   }
@@ -1455,6 +1552,7 @@ finish(void)
   freearea(8);      /* temporary filenames and pathnames space  */
   free_getitem_p(); /* getitem_p tbl contains area 8 pointers */
   destroy_action_map(&phase_dump_map);
+  phasestat_fini();
   /*free( gbl.src_file );*/
   gbl.src_file = NULL;
   if (maxfilsev >= 3) {
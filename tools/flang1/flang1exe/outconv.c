@@ -47,6 +47,7 @@ static void find_collapse_allocs(void);
 static void find_collapse_defs(void);
 static void delete_collapse(int ci);
 static void find_collapse_uses(void);
+static void find_collapse_refs(void);
 static LOGICAL is_parent_loop(int lpParent, int lp);
 static void collapse_loops(void);
 static void find_descrs(void);
@@ -55,6 +56,7 @@ static void report_collapse(int lp);
 #if DEBUG
 static void dump_collapse(void);
 #endif
+static void version_contig_loops(void);
 static int position_finder(int forall, int ast);
 static void find_calls_pos(int std, int forall, int must_pos);
 static void find_mask_calls_pos(int forall);
@@ -105,6 +107,8 @@ convert_output(void)
   eliminate_barrier();
   free_brtbl();
   transform_wrapup();
+  if (flg.opt >= 2 && !XBIT(47, 0x400))
+    version_contig_loops();
   convert_simple();
   if (XBIT(58, 0x10000000))
     convert_template_instance();
@@ -295,6 +299,68 @@ gen_endsingle(int std, int single, int presinglebarrier)
   add_stmt_after(mk_stmt(A_MP_BARRIER, 0), ompstd);
 }
 
+/* Is sptr the same object in every thread of the team? */
+static LOGICAL
+shared_in_team(int sptr)
+{
+  int midnum;
+
+  if (SCG(sptr) == SC_PRIVATE || THREADG(sptr))
+    return FALSE;
+  if (SCG(sptr) == SC_BASED) {
+    midnum = MIDNUMG(sptr);
+    if (midnum > NOSYM && (SCG(midnum) == SC_PRIVATE || THREADG(midnum)))
+      return FALSE;
+  }
+  return TRUE;
+}
+
+/*
+ * A call to a fast MATMUL routine (see mmul() in func.c) in a WORKSHARE
+ * need not run in a SINGLE: its team variant has each thread compute a
+ * block of the result.  That requires the operands and the result to be
+ * shared, not private temporaries, and a barrier before anything reads
+ * the result.
+ */
+static LOGICAL
+gen_team_mmul(int std)
+{
+  static const FtnRtlEnum rtns[][2] = {
+      {RTE_mmul_real4, RTE_mmul_real4_team},
+      {RTE_mmul_real8, RTE_mmul_real8_team},
+      {RTE_mmul_cmplx8, RTE_mmul_cmplx8_team},
+      {RTE_mmul_cmplx16, RTE_mmul_cmplx16_team},
+  };
+  const int nrtns = sizeof(rtns) / sizeof(rtns[0]);
+  int ast = STD_AST(std);
+  int argt;
+  int fsptr;
+  int i;
+
+  if (XBIT(69, 0x4000))
+    return FALSE;
+  if (A_TYPEG(ast) != A_ICALL || A_TYPEG(A_LOPG(ast)) != A_ID ||
+      A_ARGCNTG(ast) != 13)
+    return FALSE;
+  fsptr = A_SPTRG(A_LOPG(ast));
+  for (i = 0; i < nrtns; ++i) {
+    if (strcmp(SYMNAME(fsptr), mkRteRtnNm(rtns[i][0])) == 0)
+      break;
+  }
+  if (i == nrtns)
+    return FALSE;
+  argt = A_ARGSG(ast);
+  if (!shared_in_team(sym_of_ast(ARGT_ARG(argt, 6))) ||
+      !shared_in_team(sym_of_ast(ARGT_ARG(argt, 8))) ||
+      !shared_in_team(sym_of_ast(ARGT_ARG(argt, 11))))
+    return FALSE;
+
+  fsptr = sym_mkfunc_nodesc(mkRteRtnNm(rtns[i][1]), DT_NONE);
+  A_LOPP(ast, mk_id(fsptr));
+  add_stmt_after(mk_stmt(A_MP_BARRIER, 0), std);
+  return TRUE;
+}
+
 static void
 convert_omp_workshare(void)
 {
@@ -313,6 +379,7 @@ convert_omp_workshare(void)
   int single;
   int presinglebarrier = 0;
   int parallel_depth = 0;
+  int iflevel = 0;
 
   for (std = STD_NEXT(0); std; std = STD_NEXT(std)) {
     ast = STD_AST(std);
@@ -407,9 +474,17 @@ convert_omp_workshare(void)
         }
       /* FALL THRU */
       default:
+        if (!wherelevel && gen_team_mmul(std)) {
+          std = STD_NEXT(std); /* the barrier */
+          break;
+        }
         single = mk_stmt(A_MP_SINGLE, 0);
         add_stmt_before(single, std);
         state = IN_SINGLE;
+        if (A_TYPEG(ast) == A_IFTHEN)
+          iflevel++;
+        else if (A_TYPEG(ast) == A_DOWHILE)
+          dolevel++;
         break;
       }
       break;
@@ -467,9 +542,29 @@ convert_omp_workshare(void)
           dolevel++;
         }
         break;
+      case A_DOWHILE:
+        dolevel++;
+        break;
       case A_ENDDO:
           dolevel--;
         break;
+      case A_IFTHEN:
+        iflevel++;
+        break;
+      case A_ENDIF:
+        iflevel--;
+        break;
+      case A_ICALL:
+        if (!dolevel && !iflevel && !wherelevel) {
+          /* end the SINGLE here if the whole team can do the call */
+          if (gen_team_mmul(std)) {
+            gen_endsingle(std, single, presinglebarrier);
+            presinglebarrier = 0;
+            state = IN_WRKSHR;
+            std = STD_NEXT(std); /* the barrier */
+          }
+        }
+        break;
       case A_COMMENT:
         switch (A_TYPEG(A_LOPG(ast))) {
         case A_FORALL:
@@ -4324,6 +4419,9 @@ collapse_arrays(void)
   /* Determine if all uses of each array are within their defining loops. */
   find_collapse_uses();
 
+  /* Determine if forall temps are referenced only by those defs and uses. */
+  find_collapse_refs();
+
   /* Create new scalars */
   nscalars = 0;
   for (ci = 1; ci < collapse.avail; ci++) {
@@ -4335,6 +4433,10 @@ collapse_arrays(void)
     }
     sptrArr = memsym_of_ast(COLLAPSE_ASTARR(ci));
     sptrSclr = sym_get_scalar(SYMNAME(sptrArr), "s", DDTG(DTYPEG(sptrArr)));
+    if (SCG(sptrArr) == SC_PRIVATE ||
+        (SCG(sptrArr) == SC_BASED && MIDNUMG(sptrArr) > NOSYM &&
+         SCG(MIDNUMG(sptrArr)) == SC_PRIVATE))
+      SCP(sptrSclr, SC_PRIVATE);
     COLLAPSE_ASTSCLR(ci) = mk_id(sptrSclr);
     nscalars++;
   }
@@ -4397,8 +4499,13 @@ find_collapse_allocs(void)
       astArr = A_LOPG(astSrc);
       if (A_TYPEG(astArr) != A_ID)
         continue;
-      if (!HCCSYMG(A_SPTRG(astArr)) || !VCSYMG(A_SPTRG(astArr)))
+      if (!HCCSYMG(A_SPTRG(astArr)))
         continue; /* array not compiler created */
+      if (!VCSYMG(A_SPTRG(astArr)) &&
+          (XBIT(47, 0x40) || STYPEG(A_SPTRG(astArr)) != ST_ARRAY ||
+           (!DT_ISNUMERIC(DDTG(DTYPEG(A_SPTRG(astArr)))) &&
+            !DT_ISLOG(DDTG(DTYPEG(A_SPTRG(astArr)))))))
+        continue; /* not a numeric or logical forall temp */
       ci = A_OPT2G(astArr);
       if (ci) {
         delete_collapse(ci); /* multiple ALLOCATEs found */
@@ -4465,7 +4572,7 @@ find_collapse_defs(void)
         break;
       }
       if (COLLAPSE_LP(ci)) {
-        if (lpDef != COLLAPSE_LP(ci) || DEF_LHS(def) != COLLAPSE_ASTARR(ci)) {
+        if (lpDef != COLLAPSE_LP(ci) || DEF_ADDR(def) != COLLAPSE_ASTARR(ci)) {
           /* array assigned in multiple loops or
            * different assignments in the same loop */
           delete_collapse(ci);
@@ -4517,6 +4624,57 @@ find_collapse_uses(void)
   }
 }
 
+/* The def-use chains cover the vectorizer's temps, but a forall temp may
+ * also appear where they don't look, e.g., as a whole array argument.
+ * Keep a forall temp only if every statement that mentions it, other than
+ * its ALLOCATE and DEALLOCATE, is in the defining loop itself and mentions
+ * it only as the defining subscript, and no statement of that loop
+ * assigns a variable used in the subscript.
+ */
+static void
+find_collapse_refs(void)
+{
+  int ci;
+  int std, ast, astArr, astSub;
+  int lp;
+
+  for (ci = 1; ci < collapse.avail; ci++) {
+    if (COLLAPSE_DELETE(ci))
+      continue;
+    astSub = COLLAPSE_ASTARR(ci);
+    if (A_TYPEG(astSub) != A_SUBSCR)
+      continue;
+    astArr = A_LOPG(astSub);
+    if (VCSYMG(A_SPTRG(astArr)))
+      continue;
+    lp = COLLAPSE_LP(ci);
+    if (lp == 0) {
+      delete_collapse(ci);
+      continue;
+    }
+    for (std = STD_NEXT(0); std; std = STD_NEXT(std)) {
+      if (std == COLLAPSE_STDALLOC(ci) || std == COLLAPSE_STDDEALLOC(ci))
+        continue;
+      ast = STD_AST(std);
+      if (FG_LOOP(STD_FG(std)) == lp && A_TYPEG(ast) == A_ASN &&
+          A_TYPEG(A_DESTG(ast)) == A_ID && contains_ast(astSub, A_DESTG(ast)))
+        break;
+      if (!contains_ast(ast, astArr))
+        continue;
+      if (FG_LOOP(STD_FG(std)) != lp)
+        break;
+      ast_visit(1, 1);
+      ast_replace(astSub, astb.i0);
+      ast = ast_rewrite(ast);
+      ast_unvisit();
+      if (contains_ast(ast, astArr))
+        break;
+    }
+    if (std)
+      delete_collapse(ci);
+  }
+}
+
 /* Return TRUE if lpParent is a parent loop of loop lp. */
 static LOGICAL
 is_parent_loop(int lpParent, int lp)
@@ -4713,6 +4871,258 @@ dump_collapse(void)
 
 /* END OF ARRAY COLLAPSING */
 
+/* CONTIGUITY VERSIONING */
+
+/* A pointer array may point to a noncontiguous section, so its elements are
+ * addressed with the stride and element length from its descriptor, which
+ * keeps the loops using it from being vectorized.  Nearly always the
+ * target is contiguous, so an innermost DO loop referencing pointer arrays
+ * is versioned as
+ *   if (a$sd(lmult(1)) .eq. 1 .and. a$sd(byte_len) .eq. size ...) then
+ *     <the loop, referencing a$c instead of a>
+ *   else
+ *     <the loop>
+ *   endif
+ * where a$c is a CONTIGUOUS pointer sharing a's pointer, offset and
+ * descriptor; the back end addresses it with unit stride.
+ */
+#define MAX_CONTIG_ARRAYS 4
+
+static struct {
+  int *base; /* pairs of pointer array, its CONTIGUOUS clone */
+  int size;
+  int avail;
+  int arr[MAX_CONTIG_ARRAYS]; /* arrays of the current loop */
+  int narr;
+  LOGICAL fail;
+} contig;
+
+static LOGICAL
+contig_candidate(int sptr)
+{
+  int sdsc;
+  int eltype;
+
+  if (STYPEG(sptr) != ST_ARRAY || !POINTERG(sptr) || CONTIGATTRG(sptr) ||
+      OPTARGG(sptr) || ENCLFUNCG(sptr) || MIDNUMG(sptr) <= NOSYM ||
+      PTROFFG(sptr) <= NOSYM)
+    return FALSE;
+  switch (SCG(sptr)) {
+  case SC_DUMMY:
+  case SC_LOCAL:
+  case SC_PRIVATE:
+  case SC_BASED:
+    break;
+  default:
+    return FALSE;
+  }
+  sdsc = SDSCG(sptr);
+  if (sdsc <= NOSYM || STYPEG(sdsc) == ST_PARAM || SDSCS1G(sdsc))
+    return FALSE;
+  eltype = DDTG(DTYPEG(sptr));
+  return DT_ISNUMERIC(eltype) || DT_ISLOG(eltype);
+}
+
+/* This is the callback function for version_contig_loop(). */
+static LOGICAL
+_find_contig_arrays(int ast, int *unused)
+{
+  int sptr, i;
+
+  if (A_TYPEG(ast) == A_FUNC || A_TYPEG(ast) == A_CALL ||
+      A_TYPEG(ast) == A_ICALL || A_TYPEG(ast) == A_TRIPLE) {
+    contig.fail = TRUE;
+    return TRUE;
+  }
+  if (A_TYPEG(ast) != A_SUBSCR || A_TYPEG(A_LOPG(ast)) != A_ID)
+    return FALSE;
+  sptr = A_SPTRG(A_LOPG(ast));
+  if (!contig_candidate(sptr))
+    return FALSE;
+  for (i = 0; i < contig.narr; i++)
+    if (contig.arr[i] == sptr)
+      return FALSE;
+  if (contig.narr == MAX_CONTIG_ARRAYS) {
+    contig.fail = TRUE;
+    return TRUE;
+  }
+  contig.arr[contig.narr++] = sptr;
+  return FALSE;
+}
+
+/* Return the CONTIGUOUS clone of pointer array sptr. */
+static int
+contig_clone(int sptr)
+{
+  static char sfx[] = "c";
+  int i, clone;
+
+  for (i = 0; i < contig.avail; i += 2)
+    if (contig.base[i] == sptr)
+      return contig.base[i + 1];
+  clone = get_next_sym(SYMNAME(sptr), sfx);
+  dup_sym(clone, &stb.stg_base[sptr]);
+  HCCSYMP(clone, 1);
+  CONTIGATTRP(clone, 1);
+  SCP(clone, SC_BASED);
+  SYMLKP(clone, NOSYM);
+  NEED(contig.avail + 2, contig.base, int, contig.size, contig.size + 32);
+  contig.base[contig.avail++] = sptr;
+  contig.base[contig.avail++] = clone;
+  return clone;
+}
+
+/* Can innermost loop dostd..enddostd be duplicated?  It may contain only
+ * assignments and IFs, and no labels.
+ */
+static LOGICAL
+is_versionable_loop(int dostd, int enddostd)
+{
+  int std, ast;
+
+  if (A_DOLABG(STD_AST(dostd)) || STD_LABEL(dostd) || STD_ACCEL(dostd) ||
+      STD_KERNEL(dostd))
+    return FALSE;
+  for (std = STD_PREV(dostd); std; std = STD_PREV(std)) {
+    ast = STD_AST(std);
+    if (A_TYPEG(ast) != A_COMMENT && A_TYPEG(ast) != A_CONTINUE)
+      break;
+  }
+  if (std) {
+    switch (A_TYPEG(STD_AST(std))) {
+    case A_PRAGMA:
+    case A_MP_PDO:
+    case A_MP_TASKLOOP:
+    case A_MP_DISTRIBUTE:
+    case A_MP_TARGETLOOPTRIPCOUNT:
+      /* the directive applies to this loop */
+      return FALSE;
+    }
+  }
+  for (std = STD_NEXT(dostd); std != enddostd; std = STD_NEXT(std)) {
+    ast = STD_AST(std);
+    if (STD_LABEL(std))
+      return FALSE;
+    switch (A_TYPEG(ast)) {
+    case A_ASN:
+    case A_IFTHEN:
+    case A_ELSEIF:
+    case A_ELSE:
+    case A_ENDIF:
+    case A_COMMENT:
+    case A_CONTINUE:
+      break;
+    case A_IF:
+      if (A_TYPEG(A_IFSTMTG(ast)) != A_ASN)
+        return FALSE;
+      break;
+    default:
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+/* Add a copy of stmt ast before std; return the new std. */
+static int
+add_loop_stmt_before(int ast, int std, int orig)
+{
+  int newstd;
+
+  newstd = add_stmt_before(ast, std);
+  STD_LINENO(newstd) = STD_LINENO(orig);
+  STD_FINDEX(newstd) = STD_FINDEX(orig);
+  STD_PAR(newstd) = STD_PAR(orig);
+  STD_TASK(newstd) = STD_TASK(orig);
+  return newstd;
+}
+
+/* Version innermost loop dostd..enddostd on the contiguity of the pointer
+ * arrays it references.
+ */
+static void
+version_contig_loop(int dostd, int enddostd)
+{
+  int std, newstd, newast, cond, cmp, sdsc, eltype;
+  int i;
+
+  contig.narr = 0;
+  contig.fail = FALSE;
+  ast_visit(1, 1);
+  for (std = dostd; !contig.fail && std != STD_NEXT(enddostd);
+       std = STD_NEXT(std))
+    ast_traverse(STD_AST(std), _find_contig_arrays, NULL, NULL);
+  ast_unvisit();
+  if (contig.fail || contig.narr == 0)
+    return;
+
+  /* the unit-stride copy goes before the loop */
+  newstd = 0;
+  for (std = dostd; std != STD_NEXT(enddostd); std = STD_NEXT(std)) {
+    ast_visit(1, 1);
+    for (i = 0; i < contig.narr; i++)
+      ast_replace(mk_id(contig.arr[i]), mk_id(contig_clone(contig.arr[i])));
+    newast = ast_rewrite(STD_AST(std));
+    ast_unvisit();
+    /* duplicate after ast_unvisit(), which resets the copied VISIT field */
+    if (newast == STD_AST(std))
+      newast = mk_duplicate_ast(newast);
+    if (newstd)
+      add_loop_stmt_before(newast, dostd, std);
+    else
+      newstd = add_loop_stmt_before(newast, dostd, std);
+  }
+
+  cond = 0;
+  for (i = 0; i < contig.narr; i++) {
+    sdsc = SDSCG(contig.arr[i]);
+    eltype = DDTG(DTYPEG(contig.arr[i]));
+    cmp = mk_binop(OP_EQ, get_local_multiplier(sdsc, 0), astb.bnd.one,
+                   DT_LOG);
+    cond = cond ? mk_binop(OP_LAND, cond, cmp, DT_LOG) : cmp;
+    cmp = mk_binop(OP_EQ, get_byte_len(sdsc),
+                   mk_isz_cval(size_of(eltype), astb.bnd.dtype), DT_LOG);
+    cond = mk_binop(OP_LAND, cond, cmp, DT_LOG);
+  }
+  newast = mk_stmt(A_IFTHEN, 0);
+  A_IFEXPRP(newast, cond);
+  add_loop_stmt_before(newast, newstd, dostd);
+  add_loop_stmt_before(mk_stmt(A_ELSE, 0), dostd, dostd);
+  add_loop_stmt_before(mk_stmt(A_ENDIF, 0), STD_NEXT(enddostd), enddostd);
+}
+
+static void
+version_contig_loops(void)
+{
+  int std, std1, ast;
+  int enddostd;
+
+  contig.size = 32;
+  NEW(contig.base, int, contig.size);
+  contig.avail = 0;
+  for (std = STD_NEXT(0); std; std = STD_NEXT(std)) {
+    if (A_TYPEG(STD_AST(std)) != A_DO)
+      continue;
+    enddostd = 0;
+    for (std1 = STD_NEXT(std); std1; std1 = STD_NEXT(std1)) {
+      ast = STD_AST(std1);
+      if (A_TYPEG(ast) == A_DO || A_TYPEG(ast) == A_DOWHILE)
+        break;
+      if (A_TYPEG(ast) == A_ENDDO) {
+        enddostd = std1;
+        break;
+      }
+    }
+    if (enddostd && is_versionable_loop(std, enddostd)) {
+      version_contig_loop(std, enddostd);
+      std = enddostd;
+    }
+  }
+  FREE(contig.base);
+}
+
+/* END OF CONTIGUITY VERSIONING */
+
 static int
 position_finder(int forall, int ast)
 {
@@ -198,6 +198,8 @@ _parser(void)
   LOOP
   {
 
+    /* no symbol hash value is live between statements */
+    grow_sym_hash(stb.stg_avail);
     parse_init();
 
     /* loop once for each token in current Fortran stmt: */
@@ -173,6 +173,13 @@ static int bind_state = B_NONE;
 /*   define data local to Scanner module:  */
 
 static FILE *curr_fd; /* file descriptor for current input file */
+/* When curr_fd is NULL the source is read from memory; src_ptr and src_end
+ * bound the unread part (see scan_init_buffer()).
+ */
+static char *src_ptr, *src_end;
+#define SRC_GETC()                                                   \
+  (curr_fd ? getc(curr_fd)                                           \
+           : src_ptr < src_end ? (unsigned char)*src_ptr++ : EOF)
 
 static int incl_level;   /* current include level. starts at 0.  */
 static int incl_stacksz; /* current size of include stack */
@@ -467,6 +474,18 @@ scan_init(FILE *fd)
   scn.id.avl = 0;
 }
 
+/** \brief Initialize Scanner to read the main input source from memory.
+    \param buf the source text, which must stay live until it is scanned
+    \param len length of the source text in bytes
+ */
+void
+scan_init_buffer(char *buf, size_t len)
+{
+  src_ptr = buf;
+  src_end = buf + len;
+  scan_init(NULL);
+}
+
 /** \brief Lexical or syntactical error found, so re-initialize the Scanner
     so that next Fortran statement will be processed.
  */
@@ -1554,11 +1573,12 @@ _readln(int mx_len, LOGICAL len_err)
   char *p, *q;
 
   long_pragma_candidate = FALSE;
-  if ((c = getc(curr_fd)) == EOF) {
+  if ((c = SRC_GETC()) == EOF) {
     if (incl_level == 0) {
       gbl.eof_flag = TRUE;
     }
-    fclose(curr_fd);
+    if (curr_fd)
+      fclose(curr_fd);
     return NULL;
   }
   curr_line++;
@@ -1579,14 +1599,14 @@ _readln(int mx_len, LOGICAL len_err)
       }
       /* skip to the end-of-line */
       while (1) {
-        c = getc(curr_fd);
+        c = SRC_GETC();
         if (c == '\n' || c == EOF)
           break;
       }
       break;
     }
     *++p = c;
-    c = getc(curr_fd);
+    c = SRC_GETC();
     if (c == EOF) {
       /* this can't be the first character of the line; this case
        * is detected as end-of-file (see above).
@@ -5868,33 +5888,45 @@ init_ktable(KTABLE *ktable)
 {
   int nkwds;
   KWORD *base;
-  char *kwd;
   int i;
-  int ch;
+  int ch, ch2;
 
+  if (ktable->first != NULL)
+    return;
   nkwds = ktable->kcount;
   base = ktable->kwds;
+  NEW(ktable->first, short, 26 * 26);
+  BZERO(ktable->first, short, 26 * 26);
+  NEW(ktable->last, short, 26 * 26);
+  BZERO(ktable->last, short, 26 * 26);
   /*
    * Scan the keyword table (KTABLE) to determine the keywords which begin
-   * with each lowercase letter.  When completed, the first and last members
-   * of the keyword table will be used by keyword() to inclusively search
-   * the first and last keywords beginning with the first letter of an
-   * identifer.  Note that first[ch-'a'] is zero if there does not exist a
-   * keyword which begins with 'ch'.  A nonzero value, i, represents the
-   * index, i, into the KWORD table.
+   * with each pair of lowercase letters.  When completed, the first and
+   * last members of the keyword table will be used by keyword() to
+   * inclusively search the first and last keywords beginning with the
+   * first two letters of an identifer.  Note that first[KT_PAIR(ch,ch2)]
+   * is zero if there does not exist a keyword which begins with 'ch' and
+   * 'ch2'.  A nonzero value, i, represents the index, i, into the KWORD
+   * table.  One-letter keywords are recorded in single[] instead.
    */
   for (i = 1; i < nkwds; i++) {
-    ch = *(base[i].keytext) - 'a';
+    ch = base[i].keytext[0] - 'a';
+    ch2 = base[i].keytext[1] - 'a';
 #if DEBUG
-    /* ensure keywords begin with a lowercase letter */
-    if ((ch + 'a') < 'a' || (ch + 'a') > 'z') {
+    /* ensure keywords begin with lowercase letters */
+    if ((ch + 'a') < 'a' || (ch + 'a') > 'z' ||
+        (base[i].keytext[1] && ((ch2 + 'a') < 'a' || (ch2 + 'a') > 'z'))) {
       interrf(ERR_Fatal, "Illegal keyword, %s, for init_ktable",
               base[i].keytext);
     }
 #endif
-    if (ktable->first[ch] == 0)
-      ktable->first[ch] = i;
-    ktable->last[ch] = i;
+    if (base[i].keytext[1] == '\0') {
+      ktable->single[ch] = i;
+      continue;
+    }
+    if (ktable->first[KT_PAIR(ch, ch2)] == 0)
+      ktable->first[KT_PAIR(ch, ch2)] = i;
+    ktable->last[KT_PAIR(ch, ch2)] = i;
   }
 }
 
@@ -6081,29 +6113,33 @@ get_kind_value(int knd)
 static int
 keyword(char *id, KTABLE *ktable, int *keylen, LOGICAL exact)
 {
-  int chi, low, high, p, kl, cond;
+  int chi, chi2, low, high, p, cond;
   KWORD *base;
 
   /* convert first character (a letter) of an identifier into a subscript */
   chi = *id - 'a';
   if (chi < 0 || chi > 25)
     return 0; /* not a letter 'a' .. 'z' */
-  low = ktable->first[chi];
-  if (low == 0)
-    return 0; /* a keyword does not begin with the letter */
-  high = ktable->last[chi];
   base = ktable->kwds;
   /*
    * Searching for the longest keyword which is a prefix of the identifier.
+   * Only keywords beginning with the first two characters of the identifier
+   * can be longer than one letter.
    */
   p = 0;
-  for (; low <= high; low++) {
-    cond = cmp(id, base[low].keytext, keylen);
-    if (cond < 0)
-      break;
-    if (cond == 0)
-      p = low;
+  chi2 = id[1] - 'a';
+  if (chi2 >= 0 && chi2 <= 25 && (low = ktable->first[KT_PAIR(chi, chi2)])) {
+    high = ktable->last[KT_PAIR(chi, chi2)];
+    for (; low <= high; low++) {
+      cond = cmp(id, base[low].keytext, keylen);
+      if (cond < 0)
+        break;
+      if (cond == 0)
+        p = low;
+    }
   }
+  if (p == 0 && (p = ktable->single[chi]) != 0)
+    *keylen = 1;
   if (p) {
     keyword_idx = p;
     return base[p].toktyp;
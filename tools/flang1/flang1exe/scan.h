@@ -57,6 +57,7 @@ typedef enum {
 extern SCN scn;
 
 void scan_init(FILE *);
+void scan_init_buffer(char *, size_t);
 void scan_reset(void);
 void scan_fini(void);
 int get_token(INT *);
@@ -108,7 +108,11 @@ static IFACE *iface_base;
 static int iface_avail;
 static int iface_size;
 
+/* ident_base lives across statements, so it cannot use the symbol table
+ * hash values, whose range changes when stb.hashtb grows.
+ */
 static IDENT_LIST *ident_base[HASHSIZE];
+#define IDENT_HASH(nm) (hash_name(nm, strlen(nm)) % HASHSIZE)
 static LOGICAL dirty_ident_base = FALSE;
 
 static STSK *stsk; /* gen_dinit() defines, semant1() uses */
@@ -13877,7 +13881,7 @@ decr_ident_use(int ident, int proc)
   if (sem.which_pass || !dirty_ident_base || gbl.internal <= 1) {
     return;
   }
-  HASH_STR(hashval, SYMNAME(ident), strlen(SYMNAME(ident)))
+  hashval = IDENT_HASH(SYMNAME(ident));
   for (curr = ident_base[hashval]; curr; curr = curr->next) {
     if (strcmp(curr->ident, SYMNAME(ident)) == 0) {
       for (curr_proc = curr->proc_list; curr_proc;
@@ -13902,7 +13906,7 @@ defer_ident_list(int ident, int proc)
     /* Note: if STYPEG(ident) == 0, then this is an implicitly defined symbol */
     proc = SCOPEG(ident);
   }
-  HASH_STR(hashval, SYMNAME(ident), strlen(SYMNAME(ident)));
+  hashval = IDENT_HASH(SYMNAME(ident));
   for (curr = ident_base[hashval]; curr; curr = curr->next) {
     if (strcmp(curr->ident, SYMNAME(ident)) != 0)
       continue;
@@ -13947,7 +13951,7 @@ internal_proc_has_ident(int ident, int proc)
   if (!dirty_ident_base)
     return 0;
 
-  HASH_STR(hashval, SYMNAME(ident), strlen(SYMNAME(ident)));
+  hashval = IDENT_HASH(SYMNAME(ident));
   for (curr = ident_base[hashval]; curr; curr = curr->next) {
     if (strcmp(curr->ident, SYMNAME(ident)) == 0) {
       for (curr_proc = curr->proc_list; curr_proc;
@@ -105,6 +105,8 @@ static int mk_atomic_update_binop(int, int);
 static int mk_atomic_update_intr(int, int);
 static void do_map();
 static LOGICAL use_atomic_for_reduction(int);
+static LOGICAL use_tree_for_reduction(REDUC *, int);
+static int get_tree_reduction_op(REDUC *, int);
 
 #if defined(OMP_OFFLOAD_LLVM) || defined(OMP_OFFLOAD_PGI)
 static char *map_type;
@@ -8005,7 +8007,7 @@ get_atomic_rmw_op(int op)
 
 static void
 gen_reduction(REDUC *reducp, REDUC_SYM *reduc_symp, LOGICAL rmme,
-              LOGICAL in_parallel)
+              LOGICAL in_parallel, LOGICAL tree)
 {
   int ast;
   LOGICAL nobar = FALSE;
@@ -8018,6 +8020,8 @@ gen_reduction(REDUC *reducp, REDUC_SYM *reduc_symp, LOGICAL rmme,
   int ast_crit = 0;
   int ast_endcrit = 0;
   ATOMIC_RMW_OP save_aop = sem.mpaccatomic.rmw_op;
+  /* a tree reduction combines inside the caller's reduction block */
+  LOGICAL atomic = !tree && use_atomic_for_reduction(sem.doif_depth);
 
   if (rmme) {
     sptr = reduc_symp->shared;
@@ -8035,7 +8039,7 @@ gen_reduction(REDUC *reducp, REDUC_SYM *reduc_symp, LOGICAL rmme,
       return;
     }
   }
-  if (use_atomic_for_reduction(sem.doif_depth))
+  if (atomic)
     add_stmt(mk_stmt(A_MP_ATOMIC, 0));
 
   (void)mk_storage(reduc_symp->shared, &lhs);
@@ -8056,8 +8060,7 @@ gen_reduction(REDUC *reducp, REDUC_SYM *reduc_symp, LOGICAL rmme,
      *    shared  <-- intrin(shared, private)
      */
     (void)ref_intrin(&intrin, arg1);
-    if (use_atomic_for_reduction(sem.doif_depth) &&
-        sem.mpaccatomic.rmw_op != AOP_UNDEF) {
+    if (atomic && sem.mpaccatomic.rmw_op != AOP_UNDEF) {
       MEMORY_ORDER save_mem_order = sem.mpaccatomic.mem_order;
       sem.mpaccatomic.mem_order = MO_SEQ_CST;
       mklvalue(&lhs, 1);
@@ -8069,7 +8072,7 @@ gen_reduction(REDUC *reducp, REDUC_SYM *reduc_symp, LOGICAL rmme,
       sem.mpaccatomic.mem_order = save_mem_order;
       add_stmt(mk_stmt(A_MP_ENDATOMIC, 0));
       goto end_reduction;
-    } else {
+    } else if (!tree) {
       add_stmt(mk_stmt(A_MP_ENDATOMIC, 0));
       noatomic = TRUE;
       ast_crit = emit_bcs_ecs(A_MP_CRITICAL);
@@ -8103,7 +8106,7 @@ gen_reduction(REDUC *reducp, REDUC_SYM *reduc_symp, LOGICAL rmme,
     SST_ASTP(&op1, ast);
     SST_SHAPEP(&op1, A_SHAPEG(ast));
 
-    if (use_atomic_for_reduction(sem.doif_depth)&& get_atomic_rmw_op(opc) != AOP_UNDEF) {
+    if (atomic && get_atomic_rmw_op(opc) != AOP_UNDEF) {
       MEMORY_ORDER save_mem_order = sem.mpaccatomic.mem_order;
 
       sem.mpaccatomic.rmw_op = get_atomic_rmw_op(opc);
@@ -8116,7 +8119,7 @@ gen_reduction(REDUC *reducp, REDUC_SYM *reduc_symp, LOGICAL rmme,
       sem.mpaccatomic.mem_order = save_mem_order;
       add_stmt(mk_stmt(A_MP_ENDATOMIC, 0));
       goto end_reduction;
-    } else {
+    } else if (!tree) {
       add_stmt(mk_stmt(A_MP_ENDATOMIC, 0));
       ast_crit = emit_bcs_ecs(A_MP_CRITICAL);
       noatomic = TRUE;
@@ -8140,6 +8143,61 @@ end_reduction:
   }
 }
 
+/*
+ * Combine the reduction items with the __kmpc_reduce_nowait protocol:
+ *    begin reduction
+ *    reduction item (shared, private, MP_RED_ op) ...
+ *    critical __cs__reduction
+ *      shared <-- shared <op> private ...
+ *    endcritical __cs__reduction
+ *    end reduction
+ * The back-end turns the critical section into the block which the
+ * runtime enters once per thread, or once per team after combining the
+ * private copies in a tree; the semaphore is the lock used when the
+ * runtime chooses a critical section.
+ */
+static void
+gen_tree_reduction(REDUC *red, LOGICAL in_parallel)
+{
+  REDUC *reducp;
+  REDUC_SYM *reduc_symp;
+  int ast, ast_crit, ast_endcrit;
+  int sem_sptr;
+
+  (void)add_stmt(mk_stmt(A_MP_BREDUCTION, 0));
+  for (reducp = red; reducp; reducp = reducp->next) {
+    for (reduc_symp = reducp->list; reduc_symp;
+         reduc_symp = reduc_symp->next) {
+      if (reduc_symp->shared == 0)
+        continue;
+      ast = mk_stmt(A_MP_REDUCTIONITEM, 0);
+      A_SHSYMP(ast, reduc_symp->shared);
+      A_PRVSYMP(ast, reduc_symp->Private);
+      A_REDOPRP(ast, get_tree_reduction_op(reducp, reduc_symp->Private));
+      (void)add_stmt(ast);
+    }
+  }
+
+  sem_sptr = CMEMFG(get_csect_sym("_reduction"));
+  ast_crit = mk_stmt(A_MP_CRITICAL, 0);
+  A_MEMP(ast_crit, sem_sptr);
+  (void)add_stmt(ast_crit);
+  for (reducp = red; reducp; reducp = reducp->next) {
+    for (reduc_symp = reducp->list; reduc_symp;
+         reduc_symp = reduc_symp->next) {
+      if (reduc_symp->shared == 0)
+        continue;
+      gen_reduction(reducp, reduc_symp, FALSE, in_parallel, TRUE);
+    }
+  }
+  ast_endcrit = mk_stmt(A_MP_ENDCRITICAL, 0);
+  A_MEMP(ast_endcrit, sem_sptr);
+  (void)add_stmt(ast_endcrit);
+  A_LOPP(ast_crit, ast_endcrit);
+  A_LOPP(ast_endcrit, ast_crit);
+  (void)add_stmt(mk_stmt(A_MP_EREDUCTION, 0));
+}
+
 static void
 end_reduction(REDUC *red, int doif)
 {
@@ -8149,9 +8207,11 @@ end_reduction(REDUC *red, int doif)
   int save_par, save_target, save_teams;
   LOGICAL done = FALSE;
   LOGICAL in_parallel = FALSE;
+  LOGICAL tree;
 
   if (red == NULL)
     return;
+  tree = use_tree_for_reduction(red, doif);
 
   sem.ignore_default_none = TRUE;
   /*
@@ -8178,31 +8238,36 @@ end_reduction(REDUC *red, int doif)
           ast_crit = emit_bcs_ecs(A_MP_CRITICAL);
           done = TRUE;
         }
-        gen_reduction(reducp, reduc_symp, TRUE, in_parallel);
+        gen_reduction(reducp, reduc_symp, TRUE, in_parallel, FALSE);
       }
     }
   }
 
-  for (reducp = red; reducp; reducp = reducp->next) {
-    for (reduc_symp = reducp->list; reduc_symp; reduc_symp = reduc_symp->next) {
-      if (reduc_symp->shared == 0)
-        /* error - illegal reduction variable or set by loop above */
-        continue;
-      if (!use_atomic_for_reduction(sem.doif_depth) && !done) {
+  if (tree) {
+    gen_tree_reduction(red, in_parallel);
+  } else {
+    for (reducp = red; reducp; reducp = reducp->next) {
+      for (reduc_symp = reducp->list; reduc_symp;
+           reduc_symp = reduc_symp->next) {
+        if (reduc_symp->shared == 0)
+          /* error - illegal reduction variable or set by loop above */
+          continue;
+        if (!use_atomic_for_reduction(sem.doif_depth) && !done) {
 #ifdef OMP_OFFLOAD_LLVM
-        ast_red = mk_stmt(A_MP_BREDUCTION, 0);
-        (void) add_stmt(ast_red);
+          ast_red = mk_stmt(A_MP_BREDUCTION, 0);
+          (void) add_stmt(ast_red);
 #endif
-        ast_crit = emit_bcs_ecs(A_MP_CRITICAL);
+          ast_crit = emit_bcs_ecs(A_MP_CRITICAL);
 #ifdef OMP_OFFLOAD_LLVM
-        if (!use_atomic_for_reduction(sem.doif_depth)) {
-          A_ISOMPREDUCTIONP(ast_crit, 1);
-          gen_reduction_ompaccel(reducp, reduc_symp, FALSE, in_parallel);
-        }
+          if (!use_atomic_for_reduction(sem.doif_depth)) {
+            A_ISOMPREDUCTIONP(ast_crit, 1);
+            gen_reduction_ompaccel(reducp, reduc_symp, FALSE, in_parallel);
+          }
 #endif
-        done = TRUE;
+          done = TRUE;
+        }
+        gen_reduction(reducp, reduc_symp, FALSE, in_parallel, FALSE);
       }
-      gen_reduction(reducp, reduc_symp, FALSE, in_parallel);
     }
   }
 
@@ -8210,7 +8275,7 @@ end_reduction(REDUC *red, int doif)
   sem.parallel = save_par;
   sem.target = save_target;
   sem.teams = save_teams;
-  if (!use_atomic_for_reduction(sem.doif_depth)) {
+  if (!tree && !use_atomic_for_reduction(sem.doif_depth)) {
     ast_endcrit = emit_bcs_ecs(A_MP_ENDCRITICAL);
     A_LOPP(ast_crit, ast_endcrit);
     A_LOPP(ast_endcrit, ast_crit);
@@ -10329,6 +10394,112 @@ LOGICAL use_opt_atomic(int d)
   return OPT_OMP_ATOMIC;
 }
 
+/**
+   \brief Return the MP_RED_ operator with which the runtime combines the
+   private copy \p sptr of a reduction item, or 0 if the item must be
+   combined in a critical section.
+ */
+static int
+get_tree_reduction_op(REDUC *reducp, int sptr)
+{
+  DTYPE dtype = DTYPEG(sptr);
+  int ty = DTY(DDTG(dtype));
+  LOGICAL is_int = ty == TY_BINT || ty == TY_SINT || ty == TY_INT ||
+                   ty == TY_INT8;
+  LOGICAL is_real = ty == TY_REAL || ty == TY_DBLE;
+  LOGICAL is_log = ty == TY_BLOG || ty == TY_SLOG || ty == TY_LOG ||
+                   ty == TY_LOG8;
+  char *nm;
+
+  /* the runtime needs the element count of an array */
+  if (DTY(dtype) == TY_ARRAY &&
+      (ALLOCATTRG(sptr) || POINTERG(sptr) || extent_of(dtype) <= 0))
+    return 0;
+  switch (reducp->opr) {
+  case 0: /* intrinsic */
+    nm = SYMNAME(reducp->intrin);
+    if (strcmp(nm, "max") == 0 && (is_int || is_real))
+      return MP_RED_MAX;
+    if (strcmp(nm, "min") == 0 && (is_int || is_real))
+      return MP_RED_MIN;
+    if (strcmp(nm, "iand") == 0 && is_int)
+      return MP_RED_IAND;
+    if (strcmp(nm, "ior") == 0 && is_int)
+      return MP_RED_IOR;
+    if (strcmp(nm, "ieor") == 0 && is_int)
+      return MP_RED_IEOR;
+    return 0;
+  case OP_ADD:
+  case OP_SUB:
+  case OP_MUL:
+    if (!is_int && !is_real && ty != TY_CMPLX && ty != TY_DCMPLX)
+      return 0;
+    return reducp->opr == OP_MUL ? MP_RED_MUL : MP_RED_ADD;
+  case OP_LOG:
+    if (!is_log)
+      return 0;
+    switch (reducp->intrin) {
+    case OP_LAND:
+      return MP_RED_IAND;
+    case OP_LOR:
+      return MP_RED_IOR;
+    case OP_LNEQV:
+      return MP_RED_IEOR;
+    default:
+      /* .EQV. would need the value of .TRUE. */
+      return 0;
+    }
+  default:
+    return 0;
+  }
+}
+
+/**
+   \brief Decide whether to combine the reduction items of a host
+   parallel or worksharing construct with __kmpc_reduce_nowait, which
+   lets the runtime combine the private copies in a tree instead of
+   serializing every thread on an atomic update or critical section.
+ */
+static LOGICAL
+use_tree_for_reduction(REDUC *red, int doif)
+{
+  REDUC *reducp;
+  REDUC_SYM *reduc_symp;
+  LOGICAL any = FALSE;
+
+  if (XBIT(69, 0x2000) || XBIT(69, 0x100))
+    return FALSE;
+  switch (DI_ID(doif)) {
+  case DI_PAR:
+  case DI_PARDO:
+  case DI_PDO:
+  case DI_PARSECTS:
+  case DI_SECTS:
+  case DI_PARWORKS:
+    break;
+  default:
+    return FALSE;
+  }
+  /* a nested critical section would be held across the whole team */
+  if (DI_IN_NEST(sem.doif_depth, DI_CRITICAL))
+    return FALSE;
+#if defined(OMP_OFFLOAD_LLVM) || defined(OMP_OFFLOAD_PGI)
+  if (is_in_omptarget(sem.doif_depth))
+    return FALSE;
+#endif
+  for (reducp = red; reducp; reducp = reducp->next) {
+    for (reduc_symp = reducp->list; reduc_symp;
+         reduc_symp = reduc_symp->next) {
+      if (reduc_symp->shared == 0)
+        continue;
+      if (!get_tree_reduction_op(reducp, reduc_symp->Private))
+        return FALSE;
+      any = TRUE;
+    }
+  }
+  return any;
+}
+
 /**
    \brief Decide whether to use llvm atomic for reduction or not.
    Atomic is used only for teams reduction.
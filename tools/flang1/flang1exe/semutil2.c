@@ -12919,6 +12919,98 @@ rw_host_state(int wherefrom, int (*p_rw)(), FILE *fd)
   }
 } /* rw_host_state */
 
+/* The host and module state files are rewritten and reread for every
+ * contained subprogram.  Where the C library allows, they are streams over
+ * a growable memory buffer rather than temporary files, so saving and
+ * restoring the tables is a copy to or from memory with no file I/O.
+ */
+#if defined(__GLIBC__)
+typedef struct {
+  char *base;
+  size_t size;  /* allocated */
+  size_t avail; /* bytes written */
+  size_t pos;
+} STATEBUF;
+
+static ssize_t
+statebuf_read(void *cookie, char *buf, size_t n)
+{
+  STATEBUF *sb = (STATEBUF *)cookie;
+  if (sb->pos >= sb->avail)
+    return 0;
+  if (n > sb->avail - sb->pos)
+    n = sb->avail - sb->pos;
+  memcpy(buf, sb->base + sb->pos, n);
+  sb->pos += n;
+  return n;
+} /* statebuf_read */
+
+static ssize_t
+statebuf_write(void *cookie, const char *buf, size_t n)
+{
+  STATEBUF *sb = (STATEBUF *)cookie;
+  if (sb->pos + n > sb->size) {
+    size_t newsize = sb->size ? 2 * sb->size : 65536;
+    while (newsize < sb->pos + n)
+      newsize *= 2;
+    sb->base = sccrelal(sb->base, newsize);
+    sb->size = newsize;
+  }
+  if (sb->pos > sb->avail)
+    memset(sb->base + sb->avail, 0, sb->pos - sb->avail);
+  memcpy(sb->base + sb->pos, buf, n);
+  sb->pos += n;
+  if (sb->pos > sb->avail)
+    sb->avail = sb->pos;
+  return n;
+} /* statebuf_write */
+
+static int
+statebuf_seek(void *cookie, off64_t *offset, int whence)
+{
+  STATEBUF *sb = (STATEBUF *)cookie;
+  off64_t pos = *offset;
+  if (whence == SEEK_CUR)
+    pos += sb->pos;
+  else if (whence == SEEK_END)
+    pos += sb->avail;
+  if (pos < 0)
+    return -1;
+  sb->pos = pos;
+  *offset = pos;
+  return 0;
+} /* statebuf_seek */
+
+static int
+statebuf_close(void *cookie)
+{
+  STATEBUF *sb = (STATEBUF *)cookie;
+  if (sb->base)
+    sccfree(sb->base);
+  sccfree((char *)sb);
+  return 0;
+} /* statebuf_close */
+#endif
+
+static FILE *
+state_tmpf(void)
+{
+#if defined(__GLIBC__)
+  static cookie_io_functions_t statebuf_functions = {
+      statebuf_read, statebuf_write, statebuf_seek, statebuf_close};
+  STATEBUF *sb;
+  FILE *fd;
+
+  sb = (STATEBUF *)sccalloc(sizeof(STATEBUF));
+  BZERO(sb, STATEBUF, 1);
+  fd = fopencookie(sb, "w+", statebuf_functions);
+  if (fd != NULL)
+    return fd;
+  sccfree((char *)sb);
+#endif
+  return tmpf("b");
+} /* state_tmpf */
+
 static FILE *state_file = NULL;
 static FILE *state_append_file = NULL;
 static int saved_symavl = 0;
@@ -12961,7 +13053,7 @@ save_host_state(int wherefrom)
       fseek(state_file, 0L, 0);
     }
   } else {
-    state_file = tmpf("b");
+    state_file = state_tmpf();
     if (state_file == NULL)
       errfatal(5);
   }
@@ -13105,7 +13197,7 @@ restore_host_state(int whichpass)
     /* write the 'append' symbols into the 'append_file' */
     state_append_file_full = TRUE;
     if (!state_append_file) {
-      state_append_file = tmpf("b");
+      state_append_file = state_tmpf();
       if (state_append_file == NULL)
         errfatal(5);
       state_file_position = 0;
@@ -13297,7 +13389,7 @@ save_module_state1()
   if (modstate_file) {
     fseek(modstate_file, 0L, 0);
   } else {
-    modstate_file = tmpf("m");
+    modstate_file = state_tmpf();
     if (modstate_file == NULL)
       errfatal(5);
   }
@@ -13324,7 +13416,7 @@ save_imported_modules_state()
   if (modsave_file) {
     fseek(modsave_file, 0L, 0);
   } else {
-    modsave_file = tmpf("m");
+    modsave_file = state_tmpf();
     if (modsave_file == NULL)
       errfatal(5);
   }
@@ -13420,7 +13512,7 @@ reset_module_state()
   } else {
     /* export the module-contained subprogram */
     if (!modstate_append_file) {
-      modstate_append_file = tmpf("m");
+      modstate_append_file = state_tmpf();
       if (modstate_append_file == NULL)
         errfatal(5);
     } else {
@@ -63,6 +63,13 @@ sym_init_first(void)
 
   stb.namavl = 1;
   stb.wrdavl = 0;
+  if (stb.hashtb == NULL || stb.hashsz != HASHSIZE) {
+    /* back to the initial size, which init_hashtb assumes */
+    FREE(stb.hashtb);
+    stb.hashsz = HASHSIZE;
+    NEW(stb.hashtb, SPTR, stb.hashsz + 1);
+    assert(stb.hashtb, "sym_init: no room for hashtb", stb.hashsz, ERR_Fatal);
+  }
   for (i = 0; i <= HASHSIZE; i++)
     stb.hashtb[i] = SPTR_NULL;
 
@@ -610,6 +610,82 @@ hashcon(INT *value, int dtype, int sptr)
   return (sptr);
 }
 
+/* Recompute the hash value under which sptr was entered: constants are
+ * hashed by value the way getcon(), get_acon3() and getstring() do it,
+ * everything else by name.
+ */
+static int
+sym_hash_value(int sptr)
+{
+  int hashval;
+  INT value[2];
+  int dtype, clen;
+  char *np;
+
+  if (STYPEG(sptr) == ST_CONST) {
+    dtype = DTYPEG(sptr);
+    if (DTY(dtype) != TY_CHAR) {
+      value[0] = CONVAL1G(sptr);
+      value[1] = CONVAL2G(sptr);
+      return HASH_CON(value);
+    }
+    clen = DTY(dtype + 1);
+    clen = clen > 0 && A_ALIASG(clen) ? string_length(dtype) : 0;
+    HASH_STR(hashval, stb.n_base + CONVAL1G(sptr), clen);
+    return hashval;
+  }
+  np = SYMNAME(sptr);
+  HASH_ID(hashval, np, strlen(np));
+  return hashval;
+}
+
+/**
+   \brief Give stb.hashtb enough buckets for nsyms symbols.
+
+   The table is rebuilt with about twice as many buckets once the average
+   chain gets longer than two.  Every hash value in use refers to the old
+   size, so callers must not hold one: this is called between statements
+   and between imported symbols.
+ */
+void
+grow_sym_hash(int nsyms)
+{
+  SPTR *old, *list;
+  int oldsz, n, i, hashval;
+  SPTR sptr;
+
+  if (nsyms <= 2 * stb.hashsz)
+    return;
+  old = stb.hashtb;
+  oldsz = stb.hashsz;
+  n = 0;
+  NEW(list, SPTR, stb.stg_avail);
+  for (i = 0; i <= oldsz; ++i) {
+    for (sptr = old[i]; sptr != 0; sptr = HASHLKG(sptr)) {
+      assert(n < (int)stb.stg_avail, "grow_sym_hash: hash chains too long", i,
+             ERR_Fatal);
+      list[n++] = sptr;
+    }
+  }
+  while (stb.hashsz < nsyms)
+    stb.hashsz = 2 * stb.hashsz + 1;
+  NEW(stb.hashtb, SPTR, stb.hashsz + 1);
+  BZERO(stb.hashtb, SPTR, stb.hashsz + 1);
+  /* reinsert from the back so each chain keeps its order */
+  while (n > 0) {
+    sptr = list[--n];
+    hashval = sym_hash_value(sptr);
+    LINKSYM(sptr, hashval);
+  }
+  FREE(list);
+  FREE(old);
+#if DEBUG
+  if (DBGBIT(5, 1024))
+    fprintf(gbl.dbgfil, "grow_sym_hash: %d buckets -> %d for %d symbols\n",
+            oldsz, stb.hashsz, nsyms);
+#endif
+}
+
 SPTR
 get_acon(SPTR sym, ISZ_T off)
 {
@@ -3236,9 +3312,15 @@ dbg_symdentry(int sptr)
 
 void rw_sym_state(RW_ROUTINE, RW_FILE)
 {
-  int nw;
+  int nw, i;
 
-  RW_FD(stb.hashtb, stb.hashtb, 1);
+  i = stb.hashsz;
+  RW_SCALAR(stb.hashsz);
+  if (ISREAD() && stb.hashsz != i) {
+    FREE(stb.hashtb);
+    NEW(stb.hashtb, SPTR, stb.hashsz + 1);
+  }
+  RW_FD(stb.hashtb, SPTR, stb.hashsz + 1);
   RW_SCALAR(stb.firstusym);
   RW_SCALAR(stb.stg_avail);
   RW_SCALAR(stb.stg_cleared);
@@ -3289,6 +3371,8 @@ symtab_fini(void)
   stb.stg_size = 0;
   FREE(stb.n_base);
   stb.n_size = 0;
+  FREE(stb.hashtb);
+  stb.hashsz = 0;
   STG_DELETE(stb.dt);
   FREE(stb.w_base);
   stb.w_size = 0;
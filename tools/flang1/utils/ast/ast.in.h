@@ -120,7 +120,7 @@ typedef struct {
 
 typedef struct {
     int    ndim;	/* number of dimensions for this descriptor */
-    int    next;	/* next ASD with the same number of subscripts */
+    int    next;	/* next ASD in the same astb.asd.hshtb bucket */
     int    subs[1];	/* 1 <= size <= 7; 0 <= index <= 6 */
 } ASD;
 
@@ -135,7 +135,7 @@ typedef struct {
      * a shape of rank 'n'.  The first element of a SHD is:
      *     lwb    -> ndim, rank of the shape descriptor
      *     upb    -> next, next SHD with the same number of subscripts
-     *     stride -> not used
+     *     stride -> hshlk, next SHD in the same astb.shd.hshtb bucket
      * The ensuing 'n' elements describe the lower bound, upper bound, and
      * stride for each dimension.
      */
@@ -146,7 +146,7 @@ typedef struct {
 
 #define SHD_NDIM(i) astb.shd.stg_base[i].lwb
 #define SHD_NEXT(i) astb.shd.stg_base[i].upb
-#define SHD_FILL(i) astb.shd.stg_base[i].stride
+#define SHD_HSHLK(i) astb.shd.stg_base[i].stride
 #define SHD_LWB(i,j) astb.shd.stg_base[i+j+1].lwb
 #define SHD_UPB(i,j) astb.shd.stg_base[i+j+1].upb
 #define SHD_STRIDE(i,j) astb.shd.stg_base[i+j+1].stride
@@ -243,7 +243,7 @@ typedef struct {
 /*=================================================================*/
 
 /* hash table stuff */
-#define HSHSZ 503
+#define HSHSZ 512 /* initial number of buckets of each table; a power of 2 */
 
 /* limits */
 #define MAXAST   67108864
@@ -281,8 +281,11 @@ typedef struct {
 typedef struct {
     char   *atypes[AST_MAX + 1];
     int     attr[AST_MAX + 1];
-    int     hshtb[HSHSZ + 1];
+    int    *hshtb;	/* hshsz buckets, chained through A_HSHLK */
+    int     hshsz;
     STG_MEMBERS(AST);
+    STG_DECLARE(hshval, unsigned int); /* sidecar: hash value of each node
+                                        * entered in hshtb */
     int     firstuast;
     int     i0;		/* 'predefined' ast for integer 0 */
     int     i1;		/* 'predefined' ast for integer 1 */
@@ -293,14 +296,19 @@ typedef struct {
     int     ptr0c;	/* 'predefined' ast for non-present character I/O spec*/
     struct {
 	STG_MEMBERS(int);
-	int     hash[7];  /* max # of dimensions */
+	int    *hshtb;	/* hshsz buckets, chained through ASD_NEXT */
+	int     hshsz;
+	int     hshcnt;	/* number of ASDs */
     } asd;
     STG_DECLARE(std, STD);
     STG_DECLARE(astli, ASTLI);
     STG_DECLARE(argt, int);
     struct {
 	STG_MEMBERS(SHD);
-	int     hash[7];  /* max # of dimensions */
+	int     hash[7];  /* SHDs of each rank, chained through SHD_NEXT */
+	int    *hshtb;	/* hshsz buckets, chained through SHD_HSHLK */
+	int     hshsz;
+	int     hshcnt;	/* number of SHDs */
     } shd;
     STG_DECLARE(comstr, char);
     UINT16      implicit[55];  /* implicit dtypes:
@@ -362,6 +370,7 @@ int mk_member (int, int, DTYPE);
 int mkshape (DTYPE);
 int mk_mem_ptr_shape (int, int, DTYPE);
 int mk_shape (void);
+void rehash_shapes (void);
 int mk_atomic(int, int, int, DTYPE);
 int reduc_shape (int, int, int);
 int increase_shape (int, int, int, int);
@@ -358,6 +358,7 @@ extern SWEL *switch_base;
 /*   declare external functions from symtab.c */
 
 void sym_init(void);
+void grow_sym_hash(int);
 void init_implicit(void);
 void implicit_int(int);
 void save_implicit(LOGICAL);
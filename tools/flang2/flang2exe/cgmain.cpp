@@ -238,6 +238,33 @@ static LL_MDRef cached_unroll_disable_metadata;
 
 static bool CG_cpu_compile = false;
 
+/* Index of the instructions of the current extended basic block, consulted
+ * by ad_csed_instr(), make_bitcast() and find_load_cse() instead of scanning
+ * the instruction list backwards.  Instructions are entered lazily by
+ * csed_index_update() when a lookup is made, so that fields filled in after
+ * ad_instr(), like the ilix of a store, are seen.
+ */
+static struct {
+  /** CSE candidates for ad_csed_instr(), keyed on opcode and operand
+      identities */
+  hashset_t values;
+  /** Bitcasts for make_bitcast(), keyed on operand identity and type */
+  hashset_t bitcasts;
+  /** Instruction ilix values and store names and addresses for
+      find_load_cse() (see CSED_LOAD_KEY); a store name maps to the most
+      recent store to it */
+  hashmap_t loads;
+  /** First instruction of the current extended basic block, if any */
+  INSTR_LIST *ebb_start;
+  /** Last instruction entered; NULL forces a rebuild */
+  INSTR_LIST *last;
+} csed_index;
+
+#define CSED_LOAD_ILIX 1
+#define CSED_LOAD_STORE_NME 2
+#define CSED_LOAD_STORE_ADDR 3
+#define CSED_LOAD_KEY(kind, x) INT2HKEY(4 * (x) + (kind))
+
 static struct ret_tag {
   /** If ILI uses a hidden pointer argument to return a struct, this is it. */
   SPTR sret_sptr;
@@ -301,7 +328,11 @@ typedef struct temp_buf_list {
 static GBL_LIST *Globals;
 static GBL_LIST *recorded_Globals;
 static INSTR_LIST *Instructions;
+/** Instructions written for the current routine */
+static int instr_count;
 static CSED_ITEM *csedList;
+/** The csedList entries keyed by ilix */
+static hashmap_t csedMap;
 
 typedef struct TmpsMap {
   unsigned size;
@@ -390,6 +421,8 @@ static OPERAND *convert_float_size(OPERAND *, LL_Type *);
 static int follow_sptr_hashlk(SPTR sptr);
 static DTYPE follow_ptr_dtype(DTYPE);
 static bool same_op(OPERAND *, OPERAND *);
+static void csed_index_reset(void);
+static void csed_index_update(void);
 static void write_instructions(LL_Module *);
 static LLIntegerConditionCodes convert_to_llvm_intcc(CC_RELATION cc);
 static LLIntegerConditionCodes convert_to_llvm_uintcc(CC_RELATION cc);
@@ -1430,6 +1463,10 @@ restartConcur:
 
   /* inititalize the definition lists per routine */
   csedList = NULL;
+  if (csedMap == NULL)
+    csedMap = hashmap_alloc(hash_functions_direct);
+  else
+    hashmap_clear(csedMap);
   memset(&ret_info, 0, sizeof(ret_info));
   llvm_info.curr_func = NULL;
 
@@ -1457,6 +1494,8 @@ restartConcur:
   llvm_info.last_instr = NULL;
   llvm_info.curr_instr = NULL;
   Instructions = NULL;
+  instr_count = 0;
+  csed_index_reset();
   /* Update symbol table before we process any routine arguments, this must be
    * called before ll_abi_for_func_sptr()
    */
@@ -2852,6 +2891,7 @@ write_instructions(LL_Module *module)
     llvm_info.curr_instr = instrs;
     i_name = instrs->i_name;
     dbg_line_op_written = false;
+    ++instr_count;
 
     asrt(i_name >= 0 && i_name < I_LAST);
     DBGTRACE3("#instruction(%d) %s for ilix %d\n", i_name,
@@ -3642,43 +3682,18 @@ ad_csed_instr(LL_InstrName instr_name, int ilix, LL_Type *ll_type,
   OPERAND *operand, *new_op;
   INSTR_LIST *instr;
   if (do_cse && ENABLE_CSE_OPT && !new_ebb) {
-    instr = llvm_info.last_instr;
-    while (instr) {
-      if (instr->i_name == instr_name) {
-        operand = instr->operands;
-        new_op = operands;
-        while (operand && new_op) {
-          if (!same_op(operand, new_op))
-            break;
-          operand = operand->next;
-          new_op = new_op->next;
-        }
-        if (operand == NULL && new_op == NULL) {
-          new_op = make_tmp_op(instr->ll_type, instr->tmps);
-          if (instr->ll_type != ll_type) {
-            new_op = convert_mismatched_types(new_op, ll_type, ilix);
-          }
-          return new_op;
-        }
-      }
-      switch (instr->i_name) {
-      case I_SW:
-      case I_INVOKE:
-      case I_CALL:
-        instr = NULL;
-        break;
-      case I_BR:
-      case I_INDBR:
-      case I_NONE:
-        if (!ENABLE_ENHANCED_CSE_OPT) {
-          instr = NULL;
-          break;
-        }
-        // fall through
-      default:
-        instr = (instr->flags & STARTEBB) ? NULL : instr->prev;
-        break;
+    INSTR_LIST key;
+    const INSTR_LIST *found;
+    key.i_name = instr_name;
+    key.operands = operands;
+    csed_index_update();
+    found = (const INSTR_LIST *)hashset_lookup(csed_index.values, &key);
+    if (found) {
+      new_op = make_tmp_op(found->ll_type, found->tmps);
+      if (found->ll_type != ll_type) {
+        new_op = convert_mismatched_types(new_op, ll_type, ilix);
       }
+      return new_op;
     }
   }
   operand = make_tmp_op(ll_type, make_tmps());
@@ -6264,28 +6279,17 @@ make_bitcast(OPERAND *cast_op, LL_Type *rslt_type)
   DBGDUMPLLTYPE("cast_op type ", cast_op->ll_type)
 
   if (ENABLE_CSE_OPT) {
-    instr = llvm_info.last_instr;
-    while (instr) {
-      switch (instr->i_name) {
-      case I_BR:
-      case I_INDBR:
-      case I_NONE:
-        instr = NULL;
-        break;
-      case I_BITCAST:
-        if (same_op(cast_op, instr->operands) &&
-            strict_match(rslt_type, instr->ll_type)) {
-          operand = make_tmp_op(rslt_type, instr->tmps);
-          DBGTRACEOUT1(" returns CSE'd operand %p\n", operand)
+    INSTR_LIST key;
+    const INSTR_LIST *found;
+    key.operands = cast_op;
+    key.ll_type = rslt_type;
+    csed_index_update();
+    found = (const INSTR_LIST *)hashset_lookup(csed_index.bitcasts, &key);
+    if (found) {
+      operand = make_tmp_op(rslt_type, found->tmps);
+      DBGTRACEOUT1(" returns CSE'd operand %p\n", operand)
 
-          return operand;
-        }
-      default:
-        if (instr->flags & STARTEBB)
-          instr = NULL;
-        else
-          instr = instr->prev;
-      }
+      return operand;
     }
   }
   Curr_Instr = gen_instr(I_BITCAST, new_tmps = make_tmps(), rslt_type, cast_op);
@@ -6483,6 +6487,8 @@ remove_instr(INSTR_LIST *instr, bool update_usect_only)
       prev->next = next;
     else
       Instructions = next;
+    /* rebuild the CSE index at the next lookup */
+    csed_index.last = NULL;
   }
   for (operand = instr->operands; operand; operand = operand->next) {
     if (operand->ot_type == OT_TMP) {
@@ -6513,6 +6519,240 @@ same_op(OPERAND *op1, OPERAND *op2)
   }
 }
 
+/**
+   \brief Hash an instruction on its opcode and operand identities
+
+   Two instructions whose operands are pairwise same_op() hash the same.
+ */
+static hash_value_t
+csed_instr_hash(hash_key_t key)
+{
+  const INSTR_LIST *instr = (const INSTR_LIST *)key;
+  const OPERAND *op;
+  hash_accu_t hacc = HASH_ACCU_INIT;
+
+  HASH_ACCU_ADD(hacc, instr->i_name);
+  for (op = instr->operands; op; op = op->next) {
+    HASH_ACCU_ADD(hacc, op->ot_type);
+    switch (op->ot_type) {
+    case OT_TMP:
+      HASH_ACCU_ADD(hacc, (unsigned long)op->tmps);
+      HASH_ACCU_ADD(hacc, (unsigned long)op->tmps >> 24);
+      break;
+    case OT_VAR:
+      HASH_ACCU_ADD(hacc, op->val.sptr);
+      break;
+    case OT_CONSTVAL:
+      HASH_ACCU_ADD(hacc, op->val.conval[0]);
+      HASH_ACCU_ADD(hacc, op->val.conval[1]);
+      break;
+    default:
+      break;
+    }
+  }
+  HASH_ACCU_FINISH(hacc);
+  return HASH_ACCU_VALUE(hacc);
+}
+
+/**
+   \brief Do two instructions compute the same value, as in ad_csed_instr()?
+ */
+static int
+csed_instr_equals(hash_key_t key1, hash_key_t key2)
+{
+  const INSTR_LIST *instr1 = (const INSTR_LIST *)key1;
+  const INSTR_LIST *instr2 = (const INSTR_LIST *)key2;
+  OPERAND *op1, *op2;
+
+  if (instr1->i_name != instr2->i_name)
+    return false;
+  for (op1 = instr1->operands, op2 = instr2->operands; op1 && op2;
+       op1 = op1->next, op2 = op2->next) {
+    if (!same_op(op1, op2))
+      return false;
+  }
+  return op1 == NULL && op2 == NULL;
+}
+
+static const hash_functions_t csed_instr_hash_functions = {csed_instr_hash,
+                                                           csed_instr_equals};
+
+/**
+   \brief Hash a bitcast on its operand identity and result type
+ */
+static hash_value_t
+csed_bitcast_hash(hash_key_t key)
+{
+  const INSTR_LIST *instr = (const INSTR_LIST *)key;
+  const OPERAND *op = instr->operands;
+  hash_accu_t hacc = HASH_ACCU_INIT;
+
+  HASH_ACCU_ADD(hacc, (unsigned long)instr->ll_type);
+  HASH_ACCU_ADD(hacc, (unsigned long)instr->ll_type >> 24);
+  HASH_ACCU_ADD(hacc, op->ot_type);
+  switch (op->ot_type) {
+  case OT_TMP:
+    HASH_ACCU_ADD(hacc, (unsigned long)op->tmps);
+    HASH_ACCU_ADD(hacc, (unsigned long)op->tmps >> 24);
+    break;
+  case OT_VAR:
+    HASH_ACCU_ADD(hacc, op->val.sptr);
+    break;
+  case OT_CONSTVAL:
+    HASH_ACCU_ADD(hacc, op->val.conval[0]);
+    HASH_ACCU_ADD(hacc, op->val.conval[1]);
+    break;
+  default:
+    break;
+  }
+  HASH_ACCU_FINISH(hacc);
+  return HASH_ACCU_VALUE(hacc);
+}
+
+/**
+   \brief Do two bitcasts cast the same operand to the same type, as in
+   make_bitcast()?
+ */
+static int
+csed_bitcast_equals(hash_key_t key1, hash_key_t key2)
+{
+  const INSTR_LIST *instr1 = (const INSTR_LIST *)key1;
+  const INSTR_LIST *instr2 = (const INSTR_LIST *)key2;
+
+  return strict_match(instr1->ll_type, instr2->ll_type) &&
+         same_op(instr1->operands, instr2->operands);
+}
+
+static const hash_functions_t csed_bitcast_hash_functions = {
+    csed_bitcast_hash, csed_bitcast_equals};
+
+/**
+   \brief Can an instruction ever be found by ad_csed_instr()?
+
+   same_op() never matches operands other than temps, variables and
+   constants.
+ */
+static bool
+csed_instr_matchable(INSTR_LIST *instr)
+{
+  OPERAND *op;
+
+  for (op = instr->operands; op; op = op->next) {
+    switch (op->ot_type) {
+    case OT_TMP:
+    case OT_VAR:
+    case OT_CONSTVAL:
+      break;
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+   \brief Allocate the CSE index, or empty it for a new function
+ */
+static void
+csed_index_reset(void)
+{
+  if (csed_index.values == NULL) {
+    csed_index.values = hashset_alloc(csed_instr_hash_functions);
+    csed_index.bitcasts = hashset_alloc(csed_bitcast_hash_functions);
+    csed_index.loads = hashmap_alloc(hash_functions_direct);
+  }
+  csed_index.last = NULL;
+}
+
+/**
+   \brief Empty the CSE index
+ */
+static void
+csed_index_clear(void)
+{
+  csed_index.ebb_start = NULL;
+  hashset_clear(csed_index.values);
+  hashset_clear(csed_index.bitcasts);
+  hashmap_clear(csed_index.loads);
+}
+
+/**
+   \brief Enter the instructions added since the last lookup into the index
+
+   The index mirrors the extent of the backward scans the lookups replace:
+   nothing before a STARTEBB instruction is kept, the ad_csed_instr()
+   candidates also stop at calls, switches and, without enhanced CSE,
+   branches, and the bitcasts stop at branches.  An instruction ending a
+   scan is itself still a candidate.
+
+   When the index is empty or was invalidated by remove_instr(), it is
+   rebuilt from the start of the current extended basic block.
+ */
+static void
+csed_index_update(void)
+{
+  INSTR_LIST *instr;
+
+  if (csed_index.last) {
+    instr = csed_index.last->next;
+  } else {
+    csed_index_clear();
+    for (instr = llvm_info.last_instr; instr && instr->prev;
+         instr = instr->prev) {
+      if (instr->flags & STARTEBB)
+        break;
+    }
+  }
+  for (; instr; instr = instr->next) {
+    csed_index.last = instr;
+    if (instr->flags & STARTEBB) {
+      csed_index_clear();
+      csed_index.ebb_start = instr;
+    }
+    switch (instr->i_name) {
+    case I_SW:
+    case I_INVOKE:
+    case I_CALL:
+      hashset_clear(csed_index.values);
+      break;
+    case I_BR:
+    case I_INDBR:
+    case I_NONE:
+      if (!ENABLE_ENHANCED_CSE_OPT)
+        hashset_clear(csed_index.values);
+      hashset_clear(csed_index.bitcasts);
+      break;
+    case I_BITCAST:
+      if (instr->operands)
+        hashset_replace(csed_index.bitcasts, instr);
+      break;
+    default:
+      break;
+    }
+    if (csed_instr_matchable(instr))
+      hashset_replace(csed_index.values, instr);
+    if (instr->ilix) {
+      hash_data_t data = NULL;
+      hashmap_replace(csed_index.loads,
+                      CSED_LOAD_KEY(CSED_LOAD_ILIX, instr->ilix), &data);
+      if (instr->i_name == I_STORE) {
+        data = instr;
+        hashmap_replace(csed_index.loads,
+                        CSED_LOAD_KEY(CSED_LOAD_STORE_NME,
+                                      ILI_OPND(instr->ilix, 3)),
+                        &data);
+        if (IL_TYPE(ILI_OPC(instr->ilix)) == ILTY_STORE) {
+          data = NULL;
+          hashmap_replace(csed_index.loads,
+                          CSED_LOAD_KEY(CSED_LOAD_STORE_ADDR,
+                                        ili_opnd(instr->ilix, 2)),
+                          &data);
+        }
+      }
+    }
+  }
+}
+
 /** Return true if a load can be moved upwards (backwards in time)
     over fencing specified by the given instruction. */
 static bool
@@ -6561,6 +6801,7 @@ find_load_cse(int ilix, OPERAND *load_op, LL_Type *llt)
   int del_store_flags;
   int ld_nme;
   int c;
+  hash_data_t data;
 
   if (new_ebb || (!ilix) || (IL_TYPE(ILI_OPC(ilix)) != ILTY_LOAD))
     return NULL;
@@ -6583,18 +6824,29 @@ find_load_cse(int ilix, OPERAND *load_op, LL_Type *llt)
   del_store_instr = NULL;
   last_instr = NULL;
 
-  for (instr = llvm_info.last_instr; instr; instr = instr->prev) {
-    if ((instr->i_name == I_STORE) && instr->ilix &&
-        (ld_nme == ILI_OPND(instr->ilix, 3))) {
-      del_store_instr = instr;
-      del_store_flags = del_store_instr->flags;
-      del_store_instr->flags &= ~DELETABLE;
-      break;
-    }
-    if (instr->flags & STARTEBB) {
+  csed_index_update();
+  if (hashmap_lookup(csed_index.loads,
+                     CSED_LOAD_KEY(CSED_LOAD_STORE_NME, ld_nme), &data)) {
+    /* The index holds the instructions of the current function, which
+     * are not const; only the hashmap interface makes them so. */
+    del_store_instr =
+        const_cast<INSTR_LIST *>(static_cast<const INSTR_LIST *>(data));
+    del_store_flags = del_store_instr->flags;
+    del_store_instr->flags &= ~DELETABLE;
+  } else {
+    instr = csed_index.ebb_start;
+    if (instr)
       last_instr = (instr->i_name != I_NONE) ? instr : instr->prev;
-      break;
-    }
+    /* The scan below stops within this EBB, and cannot find anything to
+     * reuse unless the index has seen an instruction for ilix or a store
+     * to the address of the load.
+     */
+    if (!hashmap_lookup(csed_index.loads,
+                        CSED_LOAD_KEY(CSED_LOAD_ILIX, ilix), NULL) &&
+        !hashmap_lookup(csed_index.loads,
+                        CSED_LOAD_KEY(CSED_LOAD_STORE_ADDR, ILI_OPND(ilix, 1)),
+                        NULL))
+      return NULL;
   }
 
   for (instr = llvm_info.last_instr; instr != last_instr; instr = instr->prev) {
@@ -10157,6 +10409,21 @@ gen_switch(int ilix)
   return instr;
 }
 
+/**
+   \brief Find the CSE list entry for \p ilix, if any
+ */
+static CSED_ITEM *
+find_csed_item(int ilix)
+{
+  hash_data_t data;
+
+  /* csedMap holds the mutable csedList entries; only the hashmap interface
+   * makes them const. */
+  if (csedMap && hashmap_lookup(csedMap, INT2HKEY(ilix), &data))
+    return const_cast<CSED_ITEM *>(static_cast<const CSED_ITEM *>(data));
+  return NULL;
+}
+
 /**
    \brief Add \p ilix to the CSE list
    \param ilix  The ILI index to be added
@@ -10172,17 +10439,16 @@ add_to_cselist(int ilix)
 
   DBGTRACE1("#adding to cse list ilix %d", ilix)
 
-  for (csed = csedList; csed; csed = csed->next) {
-    if (ilix == csed->ilix) {
-      DBGTRACE2("#ilix %d already in cse list, count %d", ilix, ILI_COUNT(ilix))
-      return true;
-    }
+  if (find_csed_item(ilix)) {
+    DBGTRACE2("#ilix %d already in cse list, count %d", ilix, ILI_COUNT(ilix))
+    return true;
   }
   csed = (CSED_ITEM *)getitem(LLVM_LONGTERM_AREA, sizeof(CSED_ITEM));
   memset(csed, 0, sizeof(CSED_ITEM));
   csed->ilix = ilix;
   csed->next = csedList;
   csedList = csed;
+  hashmap_insert(csedMap, INT2HKEY(ilix), csed);
   build_csed_list(ilix);
   return false;
 }
@@ -10225,14 +10491,12 @@ remove_from_csed_list(int ili)
   CSED_ITEM *csed;
 
   opc = ILI_OPC(ili);
-  for (csed = csedList; csed; csed = csed->next) {
-    if (is_cseili_opcode(ILI_OPC(ili)))
-      return;
-    if (ili == csed->ilix) {
-      DBGTRACE1("#remove_from_csed_list ilix(%d)", ili)
-      ILI_COUNT(ili) = 0;
-      csed->operand = NULL;
-    }
+  if (csedList == NULL || is_cseili_opcode(opc))
+    return;
+  if ((csed = find_csed_item(ili)) != NULL) {
+    DBGTRACE1("#remove_from_csed_list ilix(%d)", ili)
+    ILI_COUNT(ili) = 0;
+    csed->operand = NULL;
   }
 
   noprs = ilis[opc].oprs;
@@ -10249,21 +10513,18 @@ get_csed_operand(int ilix)
 
   if (ILI_ALT(ilix))
     ilix = ILI_ALT(ilix);
-  for (csed = csedList; csed; csed = csed->next) {
-    if (ilix == csed->ilix) {
-      OPERAND *p = csed->operand;
-
-      if (p != NULL) {
-        int sptr = p->val.sptr;
-        DBGTRACE3(
-            "#get_csed_operand for ilix %d, operand found %p, with type (%s)",
-            ilix, p, OTNAMEG(p))
-        DBGDUMPLLTYPE("cse'd operand type ", p->ll_type)
-      } else {
-        DBGTRACE1("#get_csed_operand for ilix %d, operand found is null", ilix);
-      }
-      return &csed->operand;
+  if ((csed = find_csed_item(ilix)) != NULL) {
+    OPERAND *p = csed->operand;
+
+    if (p != NULL) {
+      DBGTRACE3(
+          "#get_csed_operand for ilix %d, operand found %p, with type (%s)",
+          ilix, p, OTNAMEG(p))
+      DBGDUMPLLTYPE("cse'd operand type ", p->ll_type)
+    } else {
+      DBGTRACE1("#get_csed_operand for ilix %d, operand found is null", ilix);
     }
+    return &csed->operand;
   }
 
   DBGTRACE1("#get_csed_operand for ilix %d not found", ilix)
@@ -12390,20 +12651,19 @@ _exit_gen_base_addr_operand:
 void
 print_tmp_name(TMPS *t)
 {
-  char tmp[10];
-  int idx = 0;
+  FILE *out = llvm_file();
 
   if (!t) {
-    idx = ++expr_id;
-    sprintf(tmp, "%%%d", idx - 1);
-    print_token(tmp);
+    ++expr_id;
+    ll_putc(out, '%');
+    ll_puti(out, expr_id - 1);
     return;
   }
 
   if (!t->id)
     t->id = ++expr_id;
-  sprintf(tmp, "%%%d", t->id - 1);
-  print_token(tmp);
+  ll_putc(out, '%');
+  ll_puti(out, t->id - 1);
 }
 
 static bool
@@ -13516,6 +13776,12 @@ cg_llvm_end(void)
 #endif
 }
 
+int
+cg_instr_count(void)
+{
+  return instr_count;
+}
+
 /**
    \brief Process the end of the SUBROUTINE (Fortran)
 
@@ -13525,6 +13791,7 @@ cg_llvm_end(void)
 void
 cg_llvm_fnend(void)
 {
+  instr_count = 0;
   if (!init_once) {
     cg_llvm_init();
   }
@@ -172,6 +172,11 @@ void cg_llvm_fnend(void);
  */
 void cg_llvm_init(void);
 
+/**
+   \brief Number of LLVM instructions written for the current routine
+ */
+int cg_instr_count(void);
+
 /**
    \brief ...
  */
@@ -23,19 +23,52 @@
  * mode == 'e' means file was open for read but had reached end of file
  */
 static char mode = ' ';
-static FILE *df = NULL;
 static void dump_buff(char);
 static DREC t;
 
+/*
+ * The dinit "file" is kept in memory.  Records and strings are laid out
+ * just as they would be written to a file, and positions are byte
+ * offsets, but seeking to the DINIT_LOC of each of many small data
+ * initializations no longer costs a system call and a buffer refill.
+ */
+static struct {
+  char *base; /* NULL means the file is not open */
+  long size;  /* bytes allocated */
+  long avail; /* bytes written */
+  long pos;   /* current position */
+} df;
+
+static void
+df_write(const void *p, long n)
+{
+  NEED(df.pos + n, df.base, char, df.size, df.size + df.pos + n);
+  memcpy(df.base + df.pos, p, n);
+  df.pos += n;
+  if (df.pos > df.avail)
+    df.avail = df.pos;
+}
+
+/* Return the number of bytes read, which is short at end of file. */
+static long
+df_read(void *p, long n)
+{
+  if (n > df.avail - df.pos)
+    n = df.pos < df.avail ? df.avail - df.pos : 0;
+  memcpy(p, df.base + df.pos, n);
+  df.pos += n;
+  return n;
+}
+
 /*****************************************************************/
 
 void
 dinit_init(void)
 {
     mode = ' '; /* neither read nor write */
-  if (df) {
+  if (df.base) {
     mode = 'e';
-    fseek(df, 0L, 0);
+    df.pos = 0;
   }
 }
 
@@ -44,13 +77,12 @@ dinit_init(void)
 void
 dinit_put(DTYPE dtype, ISZ_T conval)
 {
-  int n;
-
   if (mode == 'e') {
     mode = 'w';
   } else if (mode == ' ') {
-    if ((df = tmpf("b")) == NULL)
-      errfatal(F_0005_Unable_to_open_temporary_file);
+    df.size = 4096;
+    NEW(df.base, char, df.size);
+    df.avail = df.pos = 0;
     mode = 'w';
   } else if (mode != 'w') {
     error(F_0010_File_write_error_occurred_OP1, ERR_Fatal, 0,
@@ -62,10 +94,7 @@ dinit_put(DTYPE dtype, ISZ_T conval)
   if (DBGBIT(6, 1))
     dump_buff(mode);
 
-  n = fwrite((char *)&t, sizeof(t), 1, df);
-  if (n != 1)
-    error(F_0010_File_write_error_occurred_OP1, ERR_Fatal, 0,
-          "(data init file)", CNULL);
+  df_write(&t, sizeof(t));
 }
 
 /*
@@ -74,15 +103,12 @@ dinit_put(DTYPE dtype, ISZ_T conval)
 void
 dinit_put_string(ISZ_T len, char *str)
 {
-  int n;
-  if (df == NULL || mode != 'w')
+  if (df.base == NULL || mode != 'w')
     error(F_0010_File_write_error_occurred_OP1, ERR_Fatal, 0, "(data init file)", CNULL);
   if (DBGBIT(6, 1))
     fprintf(gbl.dbgfil, "    string(%d)\n", (int)len);
 
-  n = fwrite(str, 1, len, df);
-  if (n != len)
-    error(F_0010_File_write_error_occurred_OP1, ERR_Fatal, 0, "(data init file)", CNULL);
+  df_write(str, len);
 } /* dinit_put_string */
 
 /*******************************************************/
@@ -90,21 +116,17 @@ dinit_put_string(ISZ_T len, char *str)
 DREC *
 dinit_read(void)
 {
-  register int n;
-
-  if (mode == ' ' || mode == 'e' || df == NULL)
+  if (mode == ' ' || mode == 'e' || df.base == NULL)
     return NULL;
   if (mode == 'w') {
     t.dtype = DINIT_ENDFILE;
     t.conval = 0;
-    n = fwrite((char *)&t, sizeof(t), 1, df);
-    n = fseek(df, 0L, 0);
-    assert(n == 0, "dinit_read:bad rewind", n, ERR_Fatal);
+    df_write(&t, sizeof(t));
+    df.pos = 0;
     mode = 'r';
   }
 
-  n = fread((char *)&t, sizeof(t), 1, df);
-  if (n == 0) { /* end of file */
+  if (df_read(&t, sizeof(t)) != sizeof(t)) { /* end of file */
     mode = 'e';
     return NULL;
   }
@@ -121,9 +143,7 @@ dinit_read(void)
 void
 dinit_read_string(ISZ_T len, char *str)
 {
-  int n;
-  n = fread(str, 1, len, df);
-  if (n != len) { /* end of file */
+  if (df_read(str, len) != len) { /* end of file */
     mode = 'e';
   }
 } /* dinit_read_string */
@@ -182,7 +202,7 @@ dump_buff(char mode)
 long
 dinit_ftell(void)
 {
-  return (ftell(df));
+  return df.pos;
 }
 
 /*****************************************************************/
@@ -190,21 +210,16 @@ dinit_ftell(void)
 void
 dinit_fskip(long off)
 {
-  int n;
-
   mode = 'r';
-  n = fseek(df, off, SEEK_CUR);
-  assert(n == 0, "dinit_fskip:bad seek", n, ERR_Fatal);
+  df.pos += off;
 } /* dinit_fskip */
 
 void
 dinit_fseek(long off)
 {
-  int n;
-
   mode = 'r';
-  n = fseek(df, off, 0);
-  assert(n == 0, "dinit_fseek:bad seek", n, ERR_Fatal);
+  assert(off >= 0 && off <= df.avail, "dinit_fseek:bad seek", off, ERR_Fatal);
+  df.pos = off;
 }
 
 /*****************************************************************/
@@ -212,9 +227,9 @@ dinit_fseek(long off)
 void
 dinit_end(void)
 {
-  if (df) {
-    fclose(df);
-    df = NULL;
+  if (df.base) {
+    FREE(df.base);
+    df.base = NULL;
   }
   /* if this is block data, need to free the ilmb memory that
      would ordinarily be freed in expand.  purify MLK (memory
@@ -237,8 +252,8 @@ dinit_save(void)
 {
   savemode = mode;
   savepos = 0;
-  if (df) {
-    savepos = ftell(df);
+  if (df.base) {
+    savepos = df.pos;
   }
 } /* dinit_save */
 
@@ -246,13 +261,13 @@ void
 dinit_restore(void)
 {
   mode = savemode;
-  if (df) {
-    fseek(df, savepos, 0);
+  if (df.base) {
+    df.pos = savepos;
   }
 } /* dinit_restore */
 
 bool
 df_is_open(void)
 {
-  return (df != NULL);
+  return (df.base != NULL);
 }
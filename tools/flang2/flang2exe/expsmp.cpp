@@ -175,6 +175,22 @@ typedef struct sptrListT {
   int cplus_assign_rou;
 } sptrListT;
 
+/**
+   \brief A host reduction between MP_BREDUCTION and MP_EREDUCTION.
+
+   The front-end wraps the updates of the shared variables in a critical
+   section (P & V).  When every item can be described to the runtime
+   combiner, the P becomes a call to __kmpc_reduce_nowait() guarding the
+   updates and the V a call to __kmpc_end_reduce_nowait().
+ */
+static struct {
+  bool active;      ///< between MP_BREDUCTION and MP_EREDUCTION
+  bool critical;    ///< some item needs the critical section after all
+  int nvars;        ///< number of reduction items
+  sptrListT *items; ///< (info, private copy) of each item
+  SPTR label;       ///< skip the updates when reduce doesn't return 1
+} reduc;
+
 /* called once per function */
 void
 exp_smp_init(void)
@@ -533,6 +549,80 @@ makeCopyprivArray(const sptrListT *list, bool pass_size_addresses)
   return array;
 }
 
+/* Return the word describing a reduction item to _mp_reduce_kmpc(), or 0
+ * if the runtime can't combine its private copy 'sptr' (see mp.h).
+ */
+static ISZ_T
+reduceItemInfo(SPTR sptr, int op)
+{
+  DTYPE dtype = DTYPEG(sptr);
+  ISZ_T count = 1;
+  int type;
+
+  if (op == 0 || SCG(sptr) == SC_BASED || THREADG(sptr))
+    return 0;
+  if (DTY(dtype) == TY_ARRAY) {
+    count = extent_of(dtype);
+    dtype = DTySeqTyElement(dtype);
+  }
+  switch (DTY(dtype)) {
+  case TY_BINT:
+  case TY_BLOG:
+    type = MP_RED_I1;
+    break;
+  case TY_SINT:
+  case TY_SLOG:
+    type = MP_RED_I2;
+    break;
+  case TY_INT:
+  case TY_LOG:
+    type = MP_RED_I4;
+    break;
+  case TY_INT8:
+  case TY_LOG8:
+    type = MP_RED_I8;
+    break;
+  case TY_REAL:
+    type = MP_RED_R4;
+    break;
+  case TY_DBLE:
+    type = MP_RED_R8;
+    break;
+  case TY_CMPLX:
+    type = MP_RED_C8;
+    break;
+  case TY_DCMPLX:
+    type = MP_RED_C16;
+    break;
+  default:
+    return 0;
+  }
+  /* the word has to fit in a pointer */
+  if (count <= 0 ||
+      count >= (ISZ_T)1 << (TARGET_PTRSIZE * 8 - 1 - MP_RED_CNT_SHIFT))
+    return 0;
+  return (count << MP_RED_CNT_SHIFT) | (type << MP_RED_TYPE_SHIFT) | op;
+}
+
+/* Begin the updates of a host reduction:
+ *    if (__kmpc_reduce_nowait(..., items, _mp_reduce_kmpc, sem) != 1)
+ *      goto reduc.label
+ */
+static int
+beginReduction(SPTR sem)
+{
+  SPTR array;
+  int ili;
+
+  array = makeCopyprivArray(reduc.items, false);
+  ili = ll_make_kmpc_reduce_nowait(
+      reduc.nvars, array, ad_acon(mkfunc("_mp_reduce_kmpc"), 0), sem);
+  reduc.label = getlab();
+  ili = ad4ili(IL_ICJMP, ili, ad_icon(1), CC_NE, reduc.label);
+  RFCNTI(reduc.label);
+  return ili;
+}
+
 static int
 mkMemcpy(void)
 {
@@ -1415,6 +1505,14 @@ exp_smp(ILM_OP opc, ILM *ilmp, int curilm)
     BIH_NOMERGE(expb.curbih) = true;
     bihb.csfg = BIH_CS(expb.curbih) = true;
     sym = ILM_SymOPND(ilmp, 1);
+    if (reduc.active && !reduc.critical) {
+      ili = beginReduction(sym);
+      iltb.callfg = 1;
+      chk_block(ili);
+      ccff_info(MSGOPENMP, "OMP030", gbl.findex, gbl.lineno,
+                "Begin reduction", NULL);
+      break;
+    }
     if (!XBIT(69, 0x40) || !isUnnamedCs(sym)) {
       ili = add_mp_p(sym);
     } else {
@@ -1436,6 +1534,19 @@ exp_smp(ILM_OP opc, ILM *ilmp, int curilm)
     BIH_NOMERGE(expb.curbih) = true;
     BIH_CS(expb.curbih) = true;
     sym = ILM_SymOPND(ilmp, 1);
+    if (reduc.active && !reduc.critical) {
+      ili = ll_make_kmpc_end_reduce_nowait(sym);
+      iltb.callfg = 1;
+      chk_block(ili);
+      wr_block();
+      cr_block();
+      exp_label(reduc.label);
+      if (critCnt <= 0)
+        bihb.csfg = 0;
+      ccff_info(MSGOPENMP, "OMP031", gbl.findex, gbl.lineno,
+                "End reduction", NULL);
+      break;
+    }
     if (!XBIT(69, 0x40) || !isUnnamedCs(sym)) {
       ili = add_mp_v(sym);
     } else {
@@ -2791,14 +2902,47 @@ exp_smp(ILM_OP opc, ILM *ilmp, int curilm)
   case IM_ETASKFIRSTPRIV:
     break;
 #endif
+  case IM_MP_BREDUCTION:
+    if (ll_ilm_is_rewriting())
+      break;
 #ifdef OMP_OFFLOAD_LLVM
-    case IM_MP_REDUCTIONITEM:
-      if (flg.omptarget && gbl.ompaccel_intarget)
-        exp_ompaccel_reductionitem(ilmp, curilm);
+    if (flg.omptarget && gbl.ompaccel_intarget)
       break;
-    case IM_MP_BREDUCTION:
-    case IM_MP_EREDUCTION:
+#endif
+    reduc.active = true;
+    reduc.critical = false;
+    reduc.nvars = 0;
+    break;
+  case IM_MP_REDUCTIONITEM:
+    if (ll_ilm_is_rewriting())
+      break;
+#ifdef OMP_OFFLOAD_LLVM
+    if (flg.omptarget && gbl.ompaccel_intarget) {
+      exp_ompaccel_reductionitem(ilmp, curilm);
       break;
+    }
+#endif
+    if (reduc.active) {
+      const SPTR priv = ILM_SymOPND(ilmp, 2);
+      const ISZ_T info = reduceItemInfo(priv, ILM_OPND(ilmp, 3));
+      if (info == 0) {
+        reduc.critical = true;
+      } else {
+        const int info_ili =
+            TARGET_PTRSIZE == 8 ? ad_kconi(info) : ad_icon(info);
+        sptrListAdd(&reduc.items, priv, info_ili, false, 0, 0, priv);
+        ADDRTKNP(priv, 1);
+        ++reduc.nvars;
+      }
+    }
+    break;
+  case IM_MP_EREDUCTION:
+    if (ll_ilm_is_rewriting())
+      break;
+    reduc.active = false;
+    sptrListFree(&reduc.items);
+    break;
+#ifdef OMP_OFFLOAD_LLVM
     case IM_MP_TARGETLOOPTRIPCOUNT:
       if(flg.omptarget)
         exp_ompaccel_looptripcount(ilmp, curilm);
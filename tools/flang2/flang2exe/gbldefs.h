@@ -109,6 +109,7 @@ typedef bool LOGICAL;
 
 #if DEBUG
 void reportarea(int full);
+void areausage(size_t *held, size_t *hiwater);
 void bjunk(void *p, BIGUINT64 n);
 
 #define NEW(p, dt, n)                               \
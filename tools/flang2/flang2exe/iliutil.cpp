@@ -33,6 +33,7 @@
 #include <stdarg.h>
 #include "scutil.h"
 #include "symfun.h"
+#include "flang/ADT/hash.h"
 
 #if defined(OMP_OFFLOAD_PGI) || defined(OMP_OFFLOAD_LLVM)
 #include "ompaccel.h"
@@ -108,10 +109,37 @@ static void insert_argrsrv(ILI *);
 #define mk_prototype (SPTR) mk_prototype_llvm
 
 #define ILTABSZ 5
-#define ILHSHSZ 173
+#define ILHSH_MINSZ 1024
 #define MAXILIS 67108864
 
-static int ilhsh[ILTABSZ][ILHSHSZ];
+/* ILI hash-consing table.
+ *
+ * An open addressing, quadratically probed table of ILI indices whose size
+ * is a power of two.  Each slot caches the hash value computed when its ILI
+ * was entered, so most mismatching probes are rejected without touching the
+ * ILI area and the table can be rehashed without recomputing anything.  The
+ * table is doubled before the load factor exceeds 3/4.
+ */
+typedef struct {
+  int ilix; /* 0 marks an empty slot */
+  hash_value_t hash;
+} ILHSH_SLOT;
+
+static struct {
+  ILHSH_SLOT *tab;
+  unsigned mask;    /* table size - 1 */
+  unsigned entries; /* number of occupied slots */
+  /* statistics accumulated over the whole compilation */
+  struct {
+    unsigned long lookups;
+    unsigned long probes;
+    unsigned maxprobe;
+    unsigned maxentries;
+    unsigned maxsize;
+  } stats;
+} ilhsh;
+
+static void ilhsh_resize(unsigned);
 static bool safe_qjsr = false;
 
 #define GARB_UNREACHABLE 0
@@ -147,21 +175,18 @@ inline SPTR sptrGetILI(ILI *p) {
 void
 ili_init(void)
 {
-  int *p, cnt;
-  static int firstcall = 1;
-
   STG_ALLOC(ilib, 2048);
   STG_SET_FREELINK(ilib, ILI, hshlnk);
-  cnt = ILHSHSZ * ILTABSZ;
 
-  if (firstcall) {
-    firstcall = 0;
-  } else {
-    p = (int *)ilhsh;
-    do {
-      *p++ = 0;
-    } while (--cnt > 0);
-  }
+  /* start each function with a small, empty hash table */
+  if (ilhsh.tab != NULL)
+    FREE(ilhsh.tab);
+  ilhsh.mask = ILHSH_MINSZ - 1;
+  ilhsh.entries = 0;
+  NEW(ilhsh.tab, ILHSH_SLOT, ILHSH_MINSZ);
+  BZERO(ilhsh.tab, ILHSH_SLOT, ILHSH_MINSZ);
+  if (ILHSH_MINSZ > ilhsh.stats.maxsize)
+    ilhsh.stats.maxsize = ILHSH_MINSZ;
   /* reserve ili index 1 to be the NULL ili.  done so that a traversal
    * which uses the ILI_VISIT field as a thread can use an ili (#1) to
    * terminate the threaded list
@@ -173,6 +198,10 @@ void
 ili_cleanup(void)
 {
   STG_DELETE(ilib);
+  if (ilhsh.tab != NULL)
+    FREE(ilhsh.tab);
+  ilhsh.tab = NULL;
+  ilhsh.mask = ilhsh.entries = 0;
 }
 
 /**
@@ -8748,6 +8777,48 @@ iadd_ovf(INT c1, INT c2, INT *r)
   return false;
 }
 
+/** \brief Compute the hash value of an ILI for sharing */
+static hash_value_t
+ili_hash(ILI_OP opc, int noprs, const int *opnd)
+{
+  int i;
+  hash_accu_t hacc = HASH_ACCU_INIT;
+
+  HASH_ACCU_ADD(hacc, opc);
+  for (i = 0; i < noprs; i++)
+    HASH_ACCU_ADD(hacc, opnd[i]);
+  HASH_ACCU_FINISH(hacc);
+  return HASH_ACCU_VALUE(hacc);
+}
+
+/** \brief Rehash the ILI hash table into a table with size slots
+ *
+ * The cached hash values are reused, so an ILI keeps its place in the
+ * probe sequence of the operands it was entered with.
+ */
+static void
+ilhsh_resize(unsigned size)
+{
+  ILHSH_SLOT *old_tab = ilhsh.tab;
+  unsigned n, old_size = ilhsh.mask + 1;
+
+  NEW(ilhsh.tab, ILHSH_SLOT, size);
+  BZERO(ilhsh.tab, ILHSH_SLOT, size);
+  ilhsh.mask = size - 1;
+  for (n = 0; n < old_size; n++) {
+    if (old_tab[n].ilix) {
+      unsigned p = old_tab[n].hash & ilhsh.mask;
+      unsigned s = 1;
+      while (ilhsh.tab[p].ilix)
+        p = (p + s++) & ilhsh.mask;
+      ilhsh.tab[p] = old_tab[n];
+    }
+  }
+  FREE(old_tab);
+  if (size > ilhsh.stats.maxsize)
+    ilhsh.stats.maxsize = size;
+}
+
 /**
  * \brief enter ili into ILI area by attempting to share
  */
@@ -8755,34 +8826,32 @@ static int
 get_ili(ILI *ilip)
 {
   int i, p;
-  int indx, tab;
+  unsigned indx, step;
+  hash_value_t hash;
   ILI_OP opc = ilip->opc;
-  int val = opc;
   int noprs = ilis[opc].oprs;
 
-  /* compute the hash index for this ILI  */
-
-  for (i = 0; i < noprs; i++)
-    val ^= (ilip->opnd[i] >> (i * 4));
-  indx = val % ILHSHSZ;
-  /*
-   * calculate which hash table to use which is based on the number of
-   * operands
-   */
-
   assert(noprs <= ILTABSZ, "get_ili: noprs > ILTABSZ", opc, ERR_Severe);
-  tab = (noprs == 0) ? 0 : noprs - 1;
-  /* search the hash links for this ILI  */
 
-  for (p = ilhsh[tab][indx]; p != 0; p = ILI_HSHLNK(p)) {
-    if (opc == ILI_OPC(p)) {
+  /* compute the hash value for this ILI and search the hash table */
+  hash = ili_hash(opc, noprs, ilip->opnd);
+  ++ilhsh.stats.lookups;
+  for (indx = hash & ilhsh.mask, step = 1; (p = ilhsh.tab[indx].ilix) != 0;
+       indx = (indx + step++) & ilhsh.mask) {
+    if (ilhsh.tab[indx].hash == hash && opc == ILI_OPC(p)) {
       for (i = 1; i <= noprs; i++)
         if (ilip->opnd[i - 1] != ILI_OPND(p, i))
           goto next;
+      ilhsh.stats.probes += step;
+      if (step > ilhsh.stats.maxprobe)
+        ilhsh.stats.maxprobe = step;
       return p; /* F O U N D  */
     }
   next:;
   }
+  ilhsh.stats.probes += step;
+  if (step > ilhsh.stats.maxprobe)
+    ilhsh.stats.maxprobe = step;
 
   /*
    * NOT FOUND -- if no more storage is available, check for zero use
@@ -8792,7 +8861,7 @@ get_ili(ILI *ilip)
   p = STG_NEXT_FREELIST(ilib);
 
   /*
-   * NEW ENTRY - add the ili to the ili area and to its hash chain
+   * NEW ENTRY - add the ili to the ili area and to the hash table
    */
   BZERO(&ilib.stg_base[p], ILI, 1);
   ILI_OPCP(p, opc);
@@ -8813,14 +8882,39 @@ get_ili(ILI *ilip)
   }
 #endif
 
-  ILI_HSHLNK(p) = ilhsh[tab][indx];
-  ilhsh[tab][indx] = p;
+  ilhsh.tab[indx].ilix = p;
+  ilhsh.tab[indx].hash = hash;
+  if (++ilhsh.entries > ilhsh.stats.maxentries)
+    ilhsh.stats.maxentries = ilhsh.entries;
+  if (ilhsh.entries > ilhsh.mask - ilhsh.mask / 4)
+    ilhsh_resize(2 * (ilhsh.mask + 1));
   /*
    * Initialize nonzero fields of the ili - (here and in new_ili()).
    */
   return p;
 }
 
+/**
+   \brief Report ILI hash table statistics, one line at a time
+ */
+void
+ili_hash_report(void (*report_line)(char *))
+{
+  char buf[80];
+
+  if (ilhsh.stats.lookups == 0)
+    return;
+  sprintf(buf, "    ILI hash   %9u entries %9u slots %5u%% load",
+          ilhsh.stats.maxentries, ilhsh.stats.maxsize,
+          (unsigned)(100.0 * ilhsh.stats.maxentries / ilhsh.stats.maxsize));
+  report_line(buf);
+  sprintf(buf, "    ILI hash   %9lu lookups %9.2f probes %5u max",
+          ilhsh.stats.lookups,
+          (double)ilhsh.stats.probes / ilhsh.stats.lookups,
+          ilhsh.stats.maxprobe);
+  report_line(buf);
+}
+
 /* wrapper of new_ili for external reference. */
 
 int
@@ -8911,7 +9005,8 @@ sort_free_list(int head)
 void
 garbage_collect(void (*mark_function)(int))
 {
-  int i, j, p, q, t;
+  int i, j, p, q;
+  unsigned n;
 
   /* first, go through and mark all the ili that are reachable from
    * the ILT.  Then, call mark_function to mark any ILI that may not
@@ -8931,31 +9026,21 @@ garbage_collect(void (*mark_function)(int))
 
   /* ILI #0, #1 is special */
   ILI_VISIT(0) = ILI_VISIT(1) = GARB_VISITED;
-  /* next, go through the hash chains and delete anything that wasn't
-   * marked reachable, putting the freed ili on the linked list.
+  /* next, go through the hash table and delete anything that wasn't
+   * marked reachable, putting the freed ili on the linked list.  Then
+   * rehash the survivors, since the deletions sever probe sequences.
    */
-  for (i = 0; i < ILTABSZ; ++i)
-    for (j = 0; j < ILHSHSZ; ++j) {
-      q = 0;
-      for (p = ilhsh[i][j]; p != 0;) {
-        if (ILI_VISIT(p) == GARB_UNREACHABLE) {
-          /* unreachable */
-          if (q == 0)
-            ilhsh[i][j] = ILI_HSHLNK(p);
-          else
-            ILI_HSHLNK(q) = ILI_HSHLNK(p);
-          t = p;
-          p = ILI_HSHLNK(p);
-          STG_ADD_FREELIST(ilib, t);
-          ILI_OPCP(t, GARB_COLLECTED);
-          ILI_VISIT(t) = GARB_COLLECTED;
-        } else {
-          /* reachable */
-          q = p;
-          p = ILI_HSHLNK(p);
-        }
-      }
+  for (n = 0; n <= ilhsh.mask; ++n) {
+    p = ilhsh.tab[n].ilix;
+    if (p != 0 && ILI_VISIT(p) == GARB_UNREACHABLE) {
+      ilhsh.tab[n].ilix = 0;
+      --ilhsh.entries;
+      STG_ADD_FREELIST(ilib, p);
+      ILI_OPCP(p, GARB_COLLECTED);
+      ILI_VISIT(p) = GARB_COLLECTED;
     }
+  }
+  ilhsh_resize(ilhsh.mask + 1);
   /* finally, go through all the ILI.  Those that have been collected
    * should be marked GARB_COLLECTED.  Those that are reachable should
    * be marked GARB_VISITED.  Those marked GARB_UNREACHABLE are
@@ -10545,24 +10630,20 @@ dmpili(void)
   for (i = 1; i < ilib.stg_avail; i++) {
     dump_ili(gbl.dbgfil, i);
   }
-  if (DBGBIT(10, 1))
-    for (i = 0; i < ILTABSZ; i++) {
-      fprintf(gbl.dbgfil, "\n\n***** ILI Hash Table%2d *****\n", i);
-      for (j = 0; j < ILHSHSZ; j++)
-        if ((opn = ilhsh[i][j]) != 0) {
+  if (DBGBIT(10, 1)) {
+    fprintf(gbl.dbgfil, "\n\n***** ILI Hash Table *****\n");
+    tmp = 0;
+    for (j = 0; j <= (int)ilhsh.mask; j++)
+      if ((opn = ilhsh.tab[j].ilix) != 0) {
+        fprintf(gbl.dbgfil, " %5d.%-5d", j, opn);
+        if ((++tmp) == 6) {
           tmp = 0;
-          fprintf(gbl.dbgfil, "%3d.", j);
-          for (; opn != 0; opn = ILI_HSHLNK(opn)) {
-            fprintf(gbl.dbgfil, " %5u^", opn);
-            if ((++tmp) == 6) {
-              tmp = 0;
-              fprintf(gbl.dbgfil, "\n    ");
-            }
-          }
-          if (tmp != 0)
-            fprintf(gbl.dbgfil, "\n");
+          fprintf(gbl.dbgfil, "\n");
         }
-    }
+      }
+    if (tmp != 0)
+      fprintf(gbl.dbgfil, "\n");
+  }
 }
 
 #if DEBUG
@@ -600,6 +600,11 @@ void garbage_collect(void (*mark_function)(int));
  */
 void ili_cleanup(void);
 
+/**
+   \brief Report ILI hash table statistics, one line at a time
+ */
+void ili_hash_report(void (*report_line)(char *));
+
 /**
    \brief ...
  */
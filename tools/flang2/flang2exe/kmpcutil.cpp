@@ -164,6 +164,10 @@ public:
     case KMPC_API_ATOMIC_WR:
       return {"__kmpc_atomic_%s%d_wr", IL_NONE, DT_VOID_NONE,
               KMPC_FLAG_STR_FMT};
+    case KMPC_API_REDUCE_NOWAIT:
+      return {"__kmpc_reduce_nowait", IL_DFRIR, DT_INT, 0};
+    case KMPC_API_END_REDUCE_NOWAIT:
+      return {"__kmpc_end_reduce_nowait", IL_NONE, DT_VOID_NONE, 0};
       /* OpenMP Accelerator RT (libomptarget-nvptx) - non standard - */
     case KMPC_API_FOR_STATIC_INIT_SIMPLE_SPMD:
       return {"__kmpc_for_static_init_%d%s_simple_spmd", IL_NONE, DT_VOID_NONE,
@@ -270,6 +274,9 @@ static const struct kmpc_api_entry_t kmpc_api_calls[] = {
                             KMPC_FLAG_STR_FMT},
     [KMPC_API_ATOMIC_WR] = {"__kmpc_atomic_%s%d_wr", 0, DT_VOID_NONE,
                             KMPC_FLAG_STR_FMT},
+    [KMPC_API_REDUCE_NOWAIT] = {"__kmpc_reduce_nowait", IL_DFRIR, DT_INT, 0},
+    [KMPC_API_END_REDUCE_NOWAIT] = {"__kmpc_end_reduce_nowait", 0,
+                                    DT_VOID_NONE, 0},
     /* OpenMP Accelerator RT (libomptarget-nvptx) - non standard - */
     [KMPC_API_FOR_STATIC_INIT_SIMPLE_SPMD] =
         {"__kmpc_for_static_init_%d%s_simple_spmd", 0, DT_VOID_NONE,
@@ -790,6 +797,45 @@ ll_make_kmpc_end_critical(SPTR sem)
   return mk_kmpc_api_call(KMPC_API_END_CRITICAL, 3, arg_types, args);
 }
 
+/* Return a result or JSR ili to __kmpc_reduce_nowait().  array_sptr holds
+ * the (info, address) pairs of the nvars reduction items; reducefunc_acon
+ * combines two such arrays.
+ */
+int
+ll_make_kmpc_reduce_nowait(int nvars, SPTR array_sptr, int reducefunc_acon,
+                           SPTR sem)
+{
+  int args[7];
+  DTYPE arg_types[7] = {DT_CPTR, DT_INT,  DT_INT, (DTYPE)-1,
+                        DT_CPTR, DT_CPTR, DT_CPTR};
+  /* the runtime reads the flags of the ident when choosing a method */
+  args[6] = make_kmpc_ident_arg(); /* ident */
+  args[5] = ll_get_gtid_val_ili(); /* tid   */
+  args[4] = ad_icon(nvars);        /* num_vars */
+  if (TARGET_PTRSIZE == 8) {
+    arg_types[3] = DT_INT8;
+    args[3] = ad_kconi(size_of(DTYPEG(array_sptr))); /* reduce_size */
+  } else {
+    arg_types[3] = DT_INT;
+    args[3] = ad_icon(size_of(DTYPEG(array_sptr))); /* reduce_size */
+  }
+  args[2] = ad_acon(array_sptr, 0); /* reduce_data */
+  args[1] = reducefunc_acon;        /* reduce_func */
+  args[0] = ad_acon(sem, 0);        /* lck:= i32 [8] */
+  return mk_kmpc_api_call(KMPC_API_REDUCE_NOWAIT, 7, arg_types, args);
+}
+
+int
+ll_make_kmpc_end_reduce_nowait(SPTR sem)
+{
+  int args[3];
+  DTYPE arg_types[3] = {DT_CPTR, DT_INT, DT_CPTR};
+  args[2] = gen_null_arg();        /* ident */
+  args[1] = ll_get_gtid_val_ili(); /* tid   */
+  args[0] = ad_acon(sem, 0);       /* lck:= i32 [8] */
+  return mk_kmpc_api_call(KMPC_API_END_REDUCE_NOWAIT, 3, arg_types, args);
+}
+
 /* Return a result or JSR ili to __kmpc_push_num_teams() */
 int
 ll_make_kmpc_push_num_teams(int nteams_ili, int thread_limit_ili)
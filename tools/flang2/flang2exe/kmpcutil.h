@@ -150,6 +150,8 @@ enum {
   KMPC_API_PUSH_PROC_BIND,
   KMPC_API_ATOMIC_RD,
   KMPC_API_ATOMIC_WR,
+  KMPC_API_REDUCE_NOWAIT,
+  KMPC_API_END_REDUCE_NOWAIT,
   /* Begin - OpenMP Accelerator RT (libomptarget-nvptx) - non standard - */
   KMPC_API_PUSH_TARGET_TRIPCOUNT,
   KMPC_API_FOR_STATIC_INIT_SIMPLE_SPMD,
@@ -210,6 +212,13 @@ int ll_make_kmpc_copyprivate(SPTR array_sptr, int single_ili,
 /// Return a result or JSR ili to __kmpc_critical()
 int ll_make_kmpc_critical(SPTR sem);
 
+/// Return a result or JSR ili to __kmpc_reduce_nowait()
+int ll_make_kmpc_reduce_nowait(int nvars, SPTR array_sptr, int reducefunc_acon,
+                               SPTR sem);
+
+/// Return a JSR ili to __kmpc_end_reduce_nowait()
+int ll_make_kmpc_end_reduce_nowait(SPTR sem);
+
 /**
    \brief ...
  */
@@ -31,35 +31,58 @@ get_llvm_version(void)
   return flg.x[249] ? ((LL_IRVersion)flg.x[249]) : LL_Version_3_2;
 }
 
+/* Size of the chunks that module-managed memory is carved from. Larger
+   requests get a chunk of their own. */
+#define LL_MANAGED_CHUNK 65536
+#define LL_MANAGED_ALIGN(n) (((n) + 15) & ~(size_t)15)
+#define LL_MANAGED_HDR LL_MANAGED_ALIGN(sizeof(struct LL_ManagedMallocs_))
+
 static void *
-ll_manage_mem(LLVMModuleRef module, void *space)
+ll_manage_malloc(LLVMModuleRef module, size_t malloc_size)
 {
-  struct LL_ManagedMallocs_ *mem =
-      (struct LL_ManagedMallocs_ *)malloc(sizeof(struct LL_ManagedMallocs_));
-  mem->storage = space;
-  mem->next = module->first_malloc;
-  module->first_malloc = mem;
+  struct LL_ManagedMallocs_ *mem = module->first_malloc;
+  size_t size = LL_MANAGED_ALIGN(malloc_size);
+  void *space;
+
+  if (mem == NULL || mem->used + size > mem->size) {
+    size_t avail = LL_MANAGED_CHUNK - LL_MANAGED_HDR;
+    if (size > avail / 4) {
+      /* Put a big request in its own chunk behind the current one so that
+         the rest of the current chunk is not wasted. */
+      mem = (struct LL_ManagedMallocs_ *)malloc(LL_MANAGED_HDR + size);
+      mem->size = mem->used = size;
+      if (module->first_malloc) {
+        mem->next = module->first_malloc->next;
+        module->first_malloc->next = mem;
+      } else {
+        mem->next = NULL;
+        module->first_malloc = mem;
+      }
+      return (char *)mem + LL_MANAGED_HDR;
+    }
+    mem = (struct LL_ManagedMallocs_ *)malloc(LL_MANAGED_CHUNK);
+    mem->size = avail;
+    mem->used = 0;
+    mem->next = module->first_malloc;
+    module->first_malloc = mem;
+  }
+  space = (char *)mem + LL_MANAGED_HDR + mem->used;
+  mem->used += size;
   return space;
 }
 
 static const char *
 ll_manage_strdup(LLVMModuleRef module, const char *str)
 {
-  return (const char *)ll_manage_mem(module, strdup(str));
+  size_t len = strlen(str) + 1;
+  return (const char *)memcpy(ll_manage_malloc(module, len), str, len);
 }
 
 static void *
 ll_manage_calloc(LLVMModuleRef module, size_t members, size_t member_size)
 {
-  void *space = calloc(members, member_size);
-  return ll_manage_mem(module, space);
-}
-
-static void *
-ll_manage_malloc(LLVMModuleRef module, size_t malloc_size)
-{
-  void *space = malloc(malloc_size);
-  return ll_manage_mem(module, space);
+  size_t size = members * member_size;
+  return memset(ll_manage_malloc(module, size), 0, size);
 }
 
 static void
@@ -129,7 +152,6 @@ ll_destroy_function(struct LL_Function_ *function)
 void
 ll_destroy_mem(struct LL_ManagedMallocs_ *current)
 {
-  free(current->storage);
   free(current);
 }
 
@@ -819,9 +819,12 @@ typedef struct LL_Symbols_ {
   unsigned int num_values;
 } LL_Symbols;
 
+/** Chunk of memory owned by an LL_Module. Managed allocations are carved
+    from the front of the chunk list and live until ll_destroy_module(). */
 typedef struct LL_ManagedMallocs_ {
-  void *storage;
   struct LL_ManagedMallocs_ *next;
+  size_t size; /**< bytes available after this header */
+  size_t used; /**< bytes handed out so far */
 } LL_ManagedMallocs;
 
 typedef struct LL_Instruction_ {
@@ -1384,7 +1387,7 @@ void ll_create_sym(struct LL_Symbols_ *symbol_table, int index,
 void ll_destroy_function(LL_Function *function);
 
 /**
-   \brief ...
+   \brief Free a chunk of module-managed memory
  */
 void ll_destroy_mem(struct LL_ManagedMallocs_ *current);
 
@@ -16,6 +16,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#if defined(__GLIBC__)
+#include <stdio_ext.h>
+#endif
 
 #ifdef TARGET_LLVM_ARM64
 #include "cgllvm.h"
@@ -27,6 +30,9 @@
 
 #define SPACES "    "
 
+/* Buffer size for the IR output file */
+#define LL_OUTPUT_BUFSIZ (1 << 20)
+
 #ifdef TARGET_POWER
 #define POWER_STACK_32_BIT_NAN "2146959359" /* 0x7FF7FFFF */
 /* Two consecutive 32 bit NaNs form a 64 bit SNan*/
@@ -38,6 +44,16 @@ static int debug_calls = 0;
 static int text_calls = 0;
 static const char *ll_get_atomic_memorder(LL_Instruction *inst);
 
+void
+ll_setup_output_file(FILE *out)
+{
+  setvbuf(out, NULL, _IOFBF, LL_OUTPUT_BUFSIZ);
+#if defined(__GLIBC__)
+  /* flang2 writes the file from a single thread */
+  __fsetlocking(out, FSETLOCKING_BYCALLER);
+#endif
+}
+
 static const char *
 ll_get_linkage_string(enum LL_LinkageType linkage)
 {
@@ -653,17 +669,17 @@ ll_write_instruction(FILE *out, LL_Instruction *inst, LL_Module *module, int no_
     break;
   }
   if (!LL_MDREF_IS_NULL(inst->dbg_line_op)) {
-    fprintf(out, ", !dbg !%u", LL_MDREF_value(inst->dbg_line_op));
+    ll_puts(out, ", !dbg !");
+    ll_putu(out, LL_MDREF_value(inst->dbg_line_op));
   }
 #if DEBUG
   if (inst->comment)
     fprintf(out, " ; %s", inst->comment);
 #endif
 
-  fputc('\n', out);
+  ll_putc(out, '\n');
   if (print_branch_target)
     fprintf(out, "%s:\n", inst->operands[2]->data);
-  fflush(out);
 }
 
 /**
@@ -681,7 +697,8 @@ ll_write_object_dbg_references(FILE *out, LL_Module *m, LL_ObjToDbgList *ods)
     return;
   for (llObjtodbgFirst(ods, &i); !llObjtodbgAtEnd(&i); llObjtodbgNext(&i)) {
     LL_MDRef mdnode = llObjtodbgGet(&i);
-    fprintf(out, ", !dbg !%u", LL_MDREF_value(mdnode));
+    ll_puts(out, ", !dbg !");
+    ll_putu(out, LL_MDREF_value(mdnode));
   }
   llObjtodbgFree(ods);
 }
@@ -1487,36 +1504,43 @@ write_mdref(FILE *out, LL_Module *module, LL_MDRef rmdref,
 
   switch (LL_MDREF_kind(mdref)) {
   case MDRef_Node:
-    if (LL_MDREF_value(mdref))
-      fprintf(out, "%s!%u", tag, LL_MDREF_value(mdref));
-    else
-      fprintf(out, "null");
+    if (LL_MDREF_value(mdref)) {
+      ll_puts(out, tag);
+      ll_putc(out, '!');
+      ll_putu(out, LL_MDREF_value(mdref));
+    } else {
+      ll_puts(out, "null");
+    }
     break;
 
   case MDRef_String:
     assert(LL_MDREF_value(mdref) < module->mdstrings_count, "Bad string MDRef",
            LL_MDREF_value(mdref), ERR_Fatal);
-    fprintf(out, "%s%s", tag, module->mdstrings[LL_MDREF_value(mdref)]);
+    ll_puts(out, tag);
+    ll_puts(out, module->mdstrings[LL_MDREF_value(mdref)]);
     break;
 
   case MDRef_Constant:
     assert(LL_MDREF_value(mdref) < module->constants_count,
            "Bad constant MDRef", LL_MDREF_value(mdref), ERR_Fatal);
-    fprintf(out, "%s %s",
-            module->constants[LL_MDREF_value(mdref)]->type_struct->str,
-            module->constants[LL_MDREF_value(mdref)]->data);
+    ll_puts(out, module->constants[LL_MDREF_value(mdref)]->type_struct->str);
+    ll_putc(out, ' ');
+    ll_puts(out, module->constants[LL_MDREF_value(mdref)]->data);
     break;
 
   case MDRef_SmallInt1:
-    fprintf(out, "i1 %u", LL_MDREF_value(mdref));
+    ll_puts(out, "i1 ");
+    ll_putu(out, LL_MDREF_value(mdref));
     break;
 
   case MDRef_SmallInt32:
-    fprintf(out, "i32 %u", LL_MDREF_value(mdref));
+    ll_puts(out, "i32 ");
+    ll_putu(out, LL_MDREF_value(mdref));
     break;
 
   case MDRef_SmallInt64:
-    fprintf(out, "i64 %u", LL_MDREF_value(mdref));
+    ll_puts(out, "i64 ");
+    ll_putu(out, LL_MDREF_value(mdref));
     break;
 
   default:
@@ -1540,6 +1564,18 @@ dwarf_emission_name(int value)
   }
 }
 
+/**
+   \brief Write the "name: " label of a specialised MDNode field
+ */
+static void
+write_mdfield_label(FILE *out, int needs_comma, const MDTemplate *tmpl)
+{
+  if (needs_comma)
+    ll_puts(out, ", ");
+  ll_puts(out, tmpl->name);
+  ll_puts(out, ": ");
+}
+
 /**
    \brief Write out an an LL_MDRef as a field in a specialised MDNode class
    \param out        file to write to
@@ -1559,7 +1595,6 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
               const MDTemplate *tmpl)
 {
   unsigned value = LL_MDREF_value(mdref);
-  const char *prefix = needs_comma ? ", " : "";
   const bool mandatory = (tmpl->flags & FlgMandatory) != 0;
 
   if (tmpl->flags & FlgHidden)
@@ -1570,9 +1605,12 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
     if (value) {
       assert(tmpl->type == NodeField, "metadata elem should not be a mdnode",
              tmpl->type, ERR_Fatal);
-      fprintf(out, "%s%s: !%u", prefix, tmpl->name, value);
+      write_mdfield_label(out, needs_comma, tmpl);
+      ll_putc(out, '!');
+      ll_putu(out, value);
     } else if (mandatory) {
-      fprintf(out, "%s%s: null", prefix, tmpl->name);
+      write_mdfield_label(out, needs_comma, tmpl);
+      ll_puts(out, "null");
     } else {
       return false;
     }
@@ -1586,7 +1624,8 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
     if (!mandatory && strcmp(module->mdstrings[value], "!\"\"") == 0)
       return false;
     /* The mdstrings[] entry is formatted as !"...". String the leading !. */
-    fprintf(out, "%s%s: %s", prefix, tmpl->name, module->mdstrings[value] + 1);
+    write_mdfield_label(out, needs_comma, tmpl);
+    ll_puts(out, module->mdstrings[value] + 1);
     break;
 
   case MDRef_Constant:
@@ -1594,9 +1633,10 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
            ERR_Fatal);
     switch (tmpl->type) {
     case ValueField:
-      fprintf(out, "%s%s: %s %s", prefix, tmpl->name,
-              module->constants[value]->type_struct->str,
-              module->constants[value]->data);
+      write_mdfield_label(out, needs_comma, tmpl);
+      ll_puts(out, module->constants[value]->type_struct->str);
+      ll_putc(out, ' ');
+      ll_puts(out, module->constants[value]->data);
       break;
 
 #ifdef HOST_WIN
@@ -1609,13 +1649,15 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
         long long intval = strtoll(module->constants[value]->data, NULL, 10);
         if ((long long)INT_MIN <= intval && intval < 0) {
           /* It was most likely a 32 bit value originally. */
-          fprintf(out, "%s%s: %u", prefix, tmpl->name, (unsigned)(int)intval);
+          write_mdfield_label(out, needs_comma, tmpl);
+          ll_putu(out, (unsigned)(int)intval);
         } else {
-          fprintf(out, "%s%s: %llu", prefix, tmpl->name, intval);
+          write_mdfield_label(out, needs_comma, tmpl);
+          ll_putu(out, (unsigned long long)intval);
         }
       } else {
-        fprintf(out, "%s%s: %s", prefix, tmpl->name,
-                module->constants[value]->data);
+        write_mdfield_label(out, needs_comma, tmpl);
+        ll_puts(out, module->constants[value]->data);
       }
       break;
 
@@ -1630,7 +1672,8 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
       }
       if (!doOutput)
         return false;
-      fprintf(out, "%s%s: %s", prefix, tmpl->name, dv);
+      write_mdfield_label(out, needs_comma, tmpl);
+      ll_puts(out, dv);
     } break;
 
     default:
@@ -1646,34 +1689,39 @@ write_mdfield(FILE *out, LL_Module *module, int needs_comma, LL_MDRef mdref,
     switch (tmpl->type) {
     case UnsignedField:
     case SignedField:
-      fprintf(out, "%s%s: %u", prefix, tmpl->name, value);
+      write_mdfield_label(out, needs_comma, tmpl);
+      ll_putu(out, value);
       break;
 
     case BoolField:
       assert(value <= 1, "boolean value expected", value, ERR_Fatal);
-      fprintf(out, "%s%s: %s", prefix, tmpl->name, value ? "true" : "false");
+      write_mdfield_label(out, needs_comma, tmpl);
+      ll_puts(out, value ? "true" : "false");
       break;
 
     case DWTagField:
-      fprintf(out, "%s%s: %s", prefix, tmpl->name,
-              dwarf_tag_name(value & 0xffff));
+      write_mdfield_label(out, needs_comma, tmpl);
+      ll_puts(out, dwarf_tag_name(value & 0xffff));
       break;
 
     case DWLangField:
-      fprintf(out, "%s%s: %s", prefix, tmpl->name, dwarf_lang_name(value));
+      write_mdfield_label(out, needs_comma, tmpl);
+      ll_puts(out, dwarf_lang_name(value));
       break;
 
     case DWVirtualityField:
-      fprintf(out, "%s%s: %s", prefix, tmpl->name,
-              dwarf_virtuality_name(value));
+      write_mdfield_label(out, needs_comma, tmpl);
+      ll_puts(out, dwarf_virtuality_name(value));
       break;
 
     case DWEncodingField:
-      fprintf(out, "%s%s: %s", prefix, tmpl->name, dwarf_encoding_name(value));
+      write_mdfield_label(out, needs_comma, tmpl);
+      ll_puts(out, dwarf_encoding_name(value));
       break;
 
     case DWEmissionField:
-      fprintf(out, "%s%s: %s", prefix, tmpl->name, dwarf_emission_name(value));
+      write_mdfield_label(out, needs_comma, tmpl);
+      ll_puts(out, dwarf_emission_name(value));
       break;
 
     default:
@@ -1701,20 +1749,20 @@ write_mdnode_plain(FILE *out, LL_Module *module, const LL_MDNode *node,
   unsigned i;
 
   if (!omit_metadata_type)
-    fprintf(out, "metadata ");
+    ll_puts(out, "metadata ");
 
   if (ll_feature_use_distinct_metadata(&module->ir) && node->is_distinct)
-    fprintf(out, "distinct ");
+    ll_puts(out, "distinct ");
 
-  fprintf(out, "!{ ");
+  ll_puts(out, "!{ ");
   for (i = 0; i < node->num_elems; i++) {
     LL_MDRef mdref = LL_MDREF_INITIALIZER(0, 0);
     mdref = node->elem[i];
     if (i > 0)
-      fprintf(out, ", ");
+      ll_puts(out, ", ");
     write_mdref(out, module, mdref, omit_metadata_type);
   }
-  fprintf(out, " }\n");
+  ll_puts(out, " }\n");
 }
 
 /*
@@ -1732,16 +1780,18 @@ write_mdnode_spec(FILE *out, LL_Module *module, const LL_MDNode *node,
   int needs_comma = false;
 
   if (ll_feature_use_distinct_metadata(&module->ir) && node->is_distinct)
-    fprintf(out, "distinct ");
+    ll_puts(out, "distinct ");
 
   assert(node->num_elems <= num_fields, "metadata node has too many fields.",
          node->num_elems, ERR_Fatal);
 
-  fprintf(out, "!%s(", tmpl->name);
+  ll_putc(out, '!');
+  ll_puts(out, tmpl->name);
+  ll_putc(out, '(');
   for (i = 0; i < node->num_elems; i++)
     if (write_mdfield(out, module, needs_comma, node->elem[i], &tmpl[i + 1]))
       needs_comma = true;
-  fprintf(out, ")\n");
+  ll_puts(out, ")\n");
 }
 
 /**
@@ -1837,7 +1887,9 @@ static MDDispatch mdDispTable[LL_MDClass_MAX] = {
 INLINE static void
 emitRegularPrefix(FILE *out, unsigned mdi)
 {
-  fprintf(out, "!%u = ", mdi);
+  ll_putc(out, '!');
+  ll_putu(out, mdi);
+  ll_puts(out, " = ");
 }
 
 /** Simple helper function */
@@ -11,6 +11,52 @@
 #include <stdio.h>
 #include "ll_structure.h"
 
+/*
+ * Output primitives for the IR writers.
+ *
+ * The .ll file is produced a few characters at a time, so these helpers
+ * copy strings and format integers directly instead of sending every piece
+ * through the printf machinery.  The output stream is made fully buffered
+ * and, with glibc, exempt from stdio locking by ll_setup_output_file().
+ */
+#define ll_puts(out, s) fputs((s), (out))
+#define ll_putc(out, c) putc((c), (out))
+
+/**
+   \brief Write the decimal representation of \p val to \p out
+ */
+inline void
+ll_putu(FILE *out, unsigned long long val)
+{
+  char buf[24];
+  char *p = buf + sizeof(buf);
+  do {
+    *--p = (char)('0' + val % 10);
+    val /= 10;
+  } while (val);
+  fwrite(p, 1, buf + sizeof(buf) - p, out);
+}
+
+/**
+   \brief Write the decimal representation of \p val to \p out
+ */
+inline void
+ll_puti(FILE *out, long long val)
+{
+  if (val < 0) {
+    ll_putc(out, '-');
+    ll_putu(out, 0ULL - (unsigned long long)val);
+  } else {
+    ll_putu(out, (unsigned long long)val);
+  }
+}
+
+/**
+   \brief Make \p out, the file receiving the IR, cheap to write to in
+   small pieces
+ */
+void ll_setup_output_file(FILE *out);
+
 /**
    \brief ...
  */
@@ -255,7 +255,111 @@ static int
 name_to_hash(const char *ag_name, int len)
 {
   int hashval = ag_name[len - 1] | (ag_name[0] << 16) | (ag_name[1] << 8);
-  return hashval % AG_HASHSZ;
+  return hashval % FPTR_HASHSZ;
+}
+
+/* AG hash table lookup statistics, see ag_hash_report() */
+static struct {
+  unsigned long lookups; /* calls of ag_hash_find() */
+  unsigned long probes;  /* names compared by ag_hash_find() */
+  int maxentries;        /* largest number of entries in agb */
+  int maxsize;           /* largest number of buckets in agb */
+} ag_hash_stats;
+
+/* Hash all characters of a global name */
+static hash_value_t
+ag_name_hash(const char *ag_name)
+{
+  hash_accu_t hacc = HASH_ACCU_INIT;
+
+  for (; *ag_name; ++ag_name)
+    HASH_ACCU_ADD(hacc, (unsigned char)*ag_name);
+  HASH_ACCU_FINISH(hacc);
+  return HASH_ACCU_VALUE(hacc);
+}
+
+/* Allocate the hash buckets of an empty AG table */
+static void
+ag_hash_init(AGB_t *tab)
+{
+  tab->hashsz = AG_HASHSZ;
+  NEW(tab->hashtb, SPTR, tab->hashsz);
+  BZERO(tab->hashtb, SPTR, tab->hashsz);
+}
+
+static void
+ag_hash_free(AGB_t *tab)
+{
+  FREE(tab->hashtb);
+  tab->hashtb = NULL;
+  tab->hashsz = 0;
+}
+
+/* Enter the named entry gblsym into the hash chains of tab.  The number of
+ * buckets is doubled whenever the table has more entries than buckets.
+ */
+static void
+ag_hash_insert(AGB_t *tab, SPTR gblsym)
+{
+  int hashval;
+
+  if (tab->s_avl > tab->hashsz) {
+    int i;
+    FREE(tab->hashtb);
+    tab->hashsz *= 2;
+    NEW(tab->hashtb, SPTR, tab->hashsz);
+    BZERO(tab->hashtb, SPTR, tab->hashsz);
+    for (i = 1; i < gblsym; ++i) {
+      hashval = ag_name_hash(tab->n_base + tab->s_base[i].nmptr) &
+                (tab->hashsz - 1);
+      tab->s_base[i].hashlk = tab->hashtb[hashval];
+      tab->hashtb[hashval] = (SPTR)i;
+    }
+  }
+  hashval = ag_name_hash(tab->n_base + tab->s_base[gblsym].nmptr) &
+            (tab->hashsz - 1);
+  tab->s_base[gblsym].hashlk = tab->hashtb[hashval];
+  tab->hashtb[hashval] = gblsym;
+  if (tab == &agb) {
+    if (gblsym > ag_hash_stats.maxentries)
+      ag_hash_stats.maxentries = gblsym;
+    if (tab->hashsz > ag_hash_stats.maxsize)
+      ag_hash_stats.maxsize = tab->hashsz;
+  }
+}
+
+/* Find the entry of tab with the given name, or return SPTR_NULL */
+static SPTR
+ag_hash_find(AGB_t *tab, const char *ag_name)
+{
+  SPTR gblsym;
+  int hashval = ag_name_hash(ag_name) & (tab->hashsz - 1);
+
+  ++ag_hash_stats.lookups;
+  for (gblsym = tab->hashtb[hashval]; gblsym;
+       gblsym = tab->s_base[gblsym].hashlk) {
+    ++ag_hash_stats.probes;
+    if (!strcmp(ag_name, tab->n_base + tab->s_base[gblsym].nmptr))
+      return gblsym;
+  }
+  return SPTR_NULL;
+}
+
+void
+ag_hash_report(void (*report_line)(char *))
+{
+  char buf[80];
+
+  if (ag_hash_stats.lookups == 0)
+    return;
+  sprintf(buf, "    AG hash    %9d entries %9d chains %5u%% load",
+          ag_hash_stats.maxentries, ag_hash_stats.maxsize,
+          (unsigned)(100.0 * ag_hash_stats.maxentries / ag_hash_stats.maxsize));
+  report_line(buf);
+  sprintf(buf, "    AG hash    %9lu lookups %9.2f probes",
+          ag_hash_stats.lookups,
+          (double)ag_hash_stats.probes / ag_hash_stats.lookups);
+  report_line(buf);
 }
 
 static int
@@ -316,7 +420,7 @@ count_skip(ISZ_T old, ISZ_T New)
 static SPTR
 make_gblsym(SPTR sptr, const char *ag_name)
 {
-  int nptr, hashval;
+  int nptr;
   SPTR gblsym;
   DTYPE dtype;
 
@@ -328,9 +432,7 @@ make_gblsym(SPTR sptr, const char *ag_name)
   AG_NMPTR(gblsym) = nptr;
   AG_DLL(gblsym) = DLL_NONE;
 
-  hashval = name_to_hash(ag_name, strlen(ag_name));
-  AG_HASHLK(gblsym) = agb.hashtb[hashval];
-  agb.hashtb[hashval] = gblsym;
+  ag_hash_insert(&agb, gblsym);
 
   if (sptr) {
     AG_SC(gblsym) = SCG(sptr);
@@ -386,13 +488,7 @@ get_typedef_ag(char *ag_name, char *typeName)
 SPTR
 find_ag(const char *ag_name)
 {
-  SPTR gblsym;
-  int hashval = name_to_hash(ag_name, strlen(ag_name));
-
-  for (gblsym = agb.hashtb[hashval]; gblsym; gblsym = AG_HASHLK(gblsym))
-    if (!strcmp(ag_name, AG_NAME(gblsym)))
-      return gblsym;
-  return SPTR_NULL;
+  return ag_hash_find(&agb, ag_name);
 }
 
 /*
@@ -459,6 +555,7 @@ assemble_init(int argc, char *argv[], char *cmdline)
   agb.n_avl = 0;
   NEW(agb.s_base, AG, agb.s_size);
   NEW(agb.n_base, char, agb.n_size);
+  ag_hash_init(&agb);
 
   /* Set the inital entry to a canary */
   add_ag_typename(0, "BADTYPE");
@@ -526,6 +623,33 @@ llassem_struct_needs_cast(int sptr)
     }                                              \
   } while (0)
 
+/* Close the [N x i8] member being built, if any, and add an [n x i8]
+ * member that process_dsrt() will initialize with zeroinitializer.
+ */
+static char *
+add_zero_member(char *buf, size_t *total_alloc, ISZ_T n, ISZ_T *i8cnt,
+                int *ptrcnt)
+{
+  char tchar[32];
+  const int csz = 256;
+  const int pad = 32;
+
+  if (*i8cnt) {
+    sprintf(tchar, /*[*/ "%ld x i8] ", *i8cnt);
+    strcat(buf, tchar);
+    *i8cnt = 0;
+  }
+  if (!first_data)
+    strcat(buf, ", ");
+  CHK_REALLOC(buf, *total_alloc, csz, pad);
+  sprintf(tchar, "[%ld x i8] ", n);
+  strcat(buf, tchar);
+  CHK_REALLOC(buf, *total_alloc, csz, pad);
+  *ptrcnt = 0;
+  first_data = 0;
+  return buf;
+}
+
 /**
    \brief Create a struct type from the \c DSRT list
    \param sptr    symbol
@@ -541,6 +665,8 @@ llassem_struct_needs_cast(int sptr)
    The struct type is built as follows:
      - Combine all non-pointer together as an array of bytes,
      - Each pointer type emitted as i8*
+     - A run of at least ZERO_MEMBER_MIN zero bytes gets an array of
+       bytes of its own
 
    All callers must call <tt>free()</tt> on the returned string.
  */
@@ -596,18 +722,23 @@ get_struct_from_dsrt2(SPTR sptr, DSRT *dsrtp, ISZ_T size, int *align8,
       gbl.func_count = dsrtp->func_count;
     } else {
       if (addr < dsrtp->offset) {
-        if (ptrcnt) {
-          if (!first_data)
-            strcat(buf, ", ");
-          if (!i8cnt)
+        skip_size = count_skip(addr, dsrtp->offset);
+        if (skip_size >= ZERO_MEMBER_MIN) {
+          buf = add_zero_member(buf, &total_alloc, skip_size, &i8cnt, &ptrcnt);
+        } else {
+          if (ptrcnt) {
+            if (!first_data)
+              strcat(buf, ", ");
+            if (!i8cnt)
+              strcat(buf, "[" /*]*/);
+            ptrcnt = 0;
+          } else if (!i8cnt) {
+            if (!first_data)
+              strcat(buf, ", ");
             strcat(buf, "[" /*]*/);
-          ptrcnt = 0;
-        } else if (!i8cnt) {
-          if (!first_data)
-            strcat(buf, ", ");
-          strcat(buf, "[" /*]*/);
+          }
+          i8cnt = i8cnt + skip_size;
         }
-        i8cnt = i8cnt + count_skip(addr, dsrtp->offset);
         addr = dsrtp->offset;
         first_data = 0;
       } else if (addr > dsrtp->offset) {
@@ -660,6 +791,11 @@ get_struct_from_dsrt2(SPTR sptr, DSRT *dsrtp, ISZ_T size, int *align8,
         addr = ALIGN(addr, p->conval);
         break;
       case DINIT_ZEROES:
+        if (p->conval >= ZERO_MEMBER_MIN) {
+          buf = add_zero_member(buf, &total_alloc, p->conval, &i8cnt, &ptrcnt);
+          addr += p->conval;
+          break;
+        }
         if (ptrcnt) {
           if (!first_data)
             strcat(buf, ", ");
@@ -730,7 +866,13 @@ get_struct_from_dsrt2(SPTR sptr, DSRT *dsrtp, ISZ_T size, int *align8,
         break;
 #endif
       case DINIT_OFFSET:
-        n_skip = i8cnt + count_skip(addr, p->conval + loc_base);
+        skip_size = count_skip(addr, p->conval + loc_base);
+        if (skip_size >= ZERO_MEMBER_MIN) {
+          buf = add_zero_member(buf, &total_alloc, skip_size, &i8cnt, &ptrcnt);
+          addr = p->conval + loc_base;
+          break;
+        }
+        n_skip = i8cnt + skip_size;
         if (ptrcnt) {
           if (!first_data)
             strcat(buf, ", ");
@@ -815,13 +957,18 @@ get_struct_from_dsrt2(SPTR sptr, DSRT *dsrtp, ISZ_T size, int *align8,
   } /* end of for( ... dsrt) */
 
   if (size >= (INT)0 && (size >= addr)) {
-    if (!i8cnt && (size - addr) > 0) {
-      if (!first_data)
-        strcat(buf, ", ");
-      strcat(buf, "[" /*]*/);
-      ptrcnt = 0;
+    skip_size = count_skip(addr, size);
+    if (skip_size >= ZERO_MEMBER_MIN) {
+      buf = add_zero_member(buf, &total_alloc, skip_size, &i8cnt, &ptrcnt);
+    } else {
+      if (!i8cnt && skip_size > 0) {
+        if (!first_data)
+          strcat(buf, ", ");
+        strcat(buf, "[" /*]*/);
+        ptrcnt = 0;
+      }
+      i8cnt = i8cnt + skip_size;
     }
-    i8cnt = i8cnt + count_skip(addr, size);
   }
   if (i8cnt) {
     if (ptrcnt) {
@@ -935,7 +1082,7 @@ assem_init(void)
   agb_local.n_avl = 0;
   NEW(agb_local.s_base, AG, agb_local.s_size);
   NEW(agb_local.n_base, char, agb_local.n_size);
-  BZERO(agb_local.hashtb, int, AG_HASHSZ);
+  ag_hash_init(&agb_local);
 
   /* ptr_local - store name for function pointer per routine */
   ptr_local = 0;
@@ -945,7 +1092,7 @@ assem_init(void)
   fptr_local.n_avl = 0;
   NEW(fptr_local.s_base, FPTRSYM, fptr_local.s_size);
   NEW(fptr_local.n_base, char, fptr_local.n_size);
-  BZERO(fptr_local.hashtb, int, AG_HASHSZ);
+  BZERO(fptr_local.hashtb, int, FPTR_HASHSZ);
 
 } /* endroutine assem_init */
 
@@ -1009,6 +1156,7 @@ assem_end(void)
   ag_local = 0;
   FREE(agb_local.s_base);
   FREE(agb_local.n_base);
+  ag_hash_free(&agb_local);
   agb_local.s_base = NULL;
   agb_local.n_base = NULL;
   agb_local.s_avl = 0;
@@ -1217,6 +1365,7 @@ assemble_end(void)
 
   FREE(agb.s_base);
   FREE(agb.n_base);
+  ag_hash_free(&agb);
 } /* endroutine assemble_end */
 
 static void
@@ -1289,24 +1438,18 @@ process_dsrt(DSRT *dsrtp, ISZ_T size, char *cptr, bool stop_at_sect, ISZ_T addr)
     } else {
       if (addr < dsrtp->offset) {
         skip_cnt = dsrtp->offset - addr;
-        if (ptrcnt) {
-          if (!first_data && skip_cnt)
-            fputs(", ", ASMFIL);
-          if (!i8cnt) {
+        if (skip_cnt >= ZERO_MEMBER_MIN) {
+          put_zero_member(&i8cnt, &ptrcnt, &ptr);
+        } else {
+          if (ptrcnt || !i8cnt) {
+            if (!first_data && skip_cnt)
+              fputs(", ", ASMFIL);
             ptr = put_next_member(ptr);
-            fputc('[', ASMFIL);
+            put_i8_open();
+            ptrcnt = 0;
           }
-          ptrcnt = 0;
-        } else if (!i8cnt) {
-          if (!first_data && skip_cnt)
-            fputs(", ", ASMFIL);
-          ptr = put_next_member(ptr);
-          fputc('[', ASMFIL);
-        } else if (i8cnt) {
-          if (!first_data && skip_cnt)
-            fputs(", ", ASMFIL);
+          i8cnt = i8cnt + put_skip(addr, dsrtp->offset);
         }
-        i8cnt = i8cnt + put_skip(addr, dsrtp->offset);
         first_data = 0;
         addr = dsrtp->offset;
       } else if (addr > dsrtp->offset) {
@@ -1325,8 +1468,10 @@ process_dsrt(DSRT *dsrtp, ISZ_T size, char *cptr, bool stop_at_sect, ISZ_T addr)
       }
       if (tdtype == DINIT_SECT || tdtype == DINIT_DATASECT) {
         if (stop_at_sect) {
-          if (i8cnt)
-            fputs("] ", ASMFIL);
+          if (i8cnt) {
+            put_i8_close();
+            fputc(' ', ASMFIL);
+          }
           return dsrtp;
         }
         break;
@@ -1347,7 +1492,9 @@ process_dsrt(DSRT *dsrtp, ISZ_T size, char *cptr, bool stop_at_sect, ISZ_T addr)
 
   if (size >= 0) {
     INT skip_size = size - addr;
-    if (skip_size > 0) {
+    if (skip_size >= ZERO_MEMBER_MIN) {
+      put_zero_member(&i8cnt, &ptrcnt, &ptr);
+    } else if (skip_size > 0) {
       if (ptrcnt) {
         if (!first_data && skip_size)
           fprintf(ASMFIL, ", ");
@@ -1362,20 +1509,17 @@ process_dsrt(DSRT *dsrtp, ISZ_T size, char *cptr, bool stop_at_sect, ISZ_T addr)
         if (!first_data && skip_size)
           fprintf(ASMFIL, ", ");
         ptr = put_next_member(ptr);
-        fprintf(ASMFIL, "[");
-      } else if (i8cnt) {
-        if (!first_data && skip_size)
-          fprintf(ASMFIL, ", ");
+        put_i8_open();
       }
-    } else if (i8cnt) {
-      fprintf(ASMFIL, "] ");
+      put_skip(addr, size);
+      i8cnt = skip_size;
     }
-    put_skip(addr, size);
-    i8cnt = skip_size;
   }
   free(cptrCopy);
-  if (i8cnt)
-    fprintf(ASMFIL, "] ");
+  if (i8cnt) {
+    put_i8_close();
+    fputc(' ', ASMFIL);
+  }
 
   return dsrtp;
 }
@@ -3001,19 +3145,19 @@ put_fstr(SPTR sptr, int add_null)
     len = get_hollerith_size(sptr);
   }
 #endif
-  fprintf(ASMFIL, "@%s = internal constant %s [", get_llvm_name(sptr), retc);
+  fprintf(ASMFIL, "@%s = internal constant %s ", get_llvm_name(sptr), retc);
+  put_i8_open();
   put_string_n(stb.n_base + CONVAL1G(sptr),
-               DTyCharLength(DTYPEG(sptr)) + add_null, 0);
+               DTyCharLength(DTYPEG(sptr)) + add_null);
 #ifdef HOLLG
   if (HOLLG(sptr)) {
     while (len) {
-      fputc(',', ASMFIL);
-      put_string_n("               ", 1, 0);
+      put_string_n("               ", 1);
       --len;
     }
   }
 #endif
-  fputc(']', ASMFIL);
+  put_i8_close();
 }
 
 static void
@@ -3386,13 +3530,7 @@ get_ag_return_lltype(int gblsym)
 static SPTR
 find_local_ag(char *ag_name)
 {
-  SPTR gsym;
-  int hashval = name_to_hash(ag_name, strlen(ag_name));
-
-  for (gsym = agb_local.hashtb[hashval]; gsym; gsym = AGL_HASHLK(gsym))
-    if (!strcmp(ag_name, AGL_NAME(gsym)))
-      return gsym;
-  return SPTR_NULL;
+  return ag_hash_find(&agb_local, ag_name);
 }
 
 static int
@@ -5248,11 +5386,10 @@ SPTR
 get_dummy_ag(SPTR sptr)
 {
   SPTR gblsym;
-  int nptr, hashval;
+  int nptr;
   char *ag_name;
 
   ag_name = get_llvm_name(sptr);
-  hashval = name_to_hash(ag_name, strlen(ag_name));
   gblsym = find_local_ag(ag_name);
 
   if (gblsym)
@@ -5267,8 +5404,7 @@ get_dummy_ag(SPTR sptr)
 
   BZERO(&agb_local.s_base[gblsym], AG, 1);
   AGL_NMPTR(gblsym) = nptr;
-  AGL_HASHLK(gblsym) = agb_local.hashtb[hashval];
-  agb_local.hashtb[hashval] = gblsym;
+  ag_hash_insert(&agb_local, gblsym);
   AGL_SYMLK(gblsym) = ag_local;
   ag_local = gblsym;
   if (MIDNUMG(sptr))
@@ -76,7 +76,8 @@ ISZ_T put_skip(ISZ_T old, ISZ_T New);
 
 /* structures and routines to process assembler globals for the entire file */
 
-#define AG_HASHSZ 19
+#define AG_HASHSZ 64 /* initial number of AG hash buckets, a power of 2 */
+#define FPTR_HASHSZ 19
 #define AG_SIZE(s) agb.s_base[s].size
 #define AG_ALIGN(s) agb.s_base[s].align
 #define AG_DSIZE(s) agb.s_base[s].dsize
@@ -179,7 +180,8 @@ typedef struct AGB_t {
   char *n_base; /**< pointer to names space */
   int n_size;
   int n_avl;
-  SPTR hashtb[AG_HASHSZ];
+  SPTR *hashtb; /**< hash buckets, chained through hashlk */
+  int hashsz;   /**< number of hash buckets, a power of 2 */
 } AGB_t;
 
 extern AGB_t agb;
@@ -200,7 +202,7 @@ typedef struct fptr_local_t {
   char *n_base; /* pointer to names space */
   int n_size;
   int n_avl;
-  int hashtb[AG_HASHSZ];
+  int hashtb[FPTR_HASHSZ];
 } fptr_local_t;
 
 extern fptr_local_t fptr_local;
@@ -236,7 +238,7 @@ extern int ag_funcptr; /* list of function pointer - should be a member
                                  LOCAL(any?) and STATIC in same list */
 
 void put_i32(int);
-void put_string_n(char *, ISZ_T, int);
+void put_string_n(char *, ISZ_T);
 void put_short(int);
 void put_int4(INT);
 
@@ -368,6 +370,11 @@ int add_ag_typename(int gblsym, const char *typeName);
  */
 SPTR find_ag(const char *ag_name);
 
+/**
+   \brief Report AG hash table statistics, one line at a time
+ */
+void ag_hash_report(void (*report_line)(char *));
+
 /**
    \brief ...
  */
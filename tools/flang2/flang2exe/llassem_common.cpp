@@ -113,31 +113,75 @@ put_next_member(char *ptr)
   return ptr;
 }
 
+/* The bytes of an [N x i8] member of an initializer are written between
+ * put_i8_open() and put_i8_close().  They are printed as a string
+ * constant, c"...", or as zeroinitializer if they are all zero, rather
+ * than as one "i8 n" element per byte.  Zero bytes are counted and only
+ * printed once a nonzero byte follows them, so zero padding and large
+ * all-zero members cost nothing however long they are.
+ */
+static struct {
+  bool open;    /* between put_i8_open() and put_i8_close() */
+  bool started; /* the opening c" has been printed */
+  ISZ_T zeroes; /* zero bytes not printed yet */
+} i8run;
+
+void
+put_i8_open(void)
+{
+  assert(!i8run.open, "put_i8_open: member already open", 0, ERR_Severe);
+  i8run.open = true;
+  i8run.started = false;
+  i8run.zeroes = 0;
+}
+
+static void
+put_pending_zeroes(void)
+{
+  if (!i8run.started) {
+    fputs("c\"", ASMFIL);
+    i8run.started = true;
+  }
+  for (; i8run.zeroes > 0; --i8run.zeroes)
+    fputs("\\00", ASMFIL);
+}
+
+static void
+put_byte(int val)
+{
+  val &= 0xff;
+  assert(i8run.open, "put_byte: no member open", val, ERR_Severe);
+  if (val == 0) {
+    ++i8run.zeroes;
+    return;
+  }
+  put_pending_zeroes();
+  if (val >= ' ' && val <= '~' && val != '"' && val != '\\')
+    fputc(val, ASMFIL);
+  else
+    fprintf(ASMFIL, "\\%02X", val);
+}
+
+void
+put_i8_close(void)
+{
+  assert(i8run.open, "put_i8_close: no member open", 0, ERR_Severe);
+  if (i8run.started) {
+    put_pending_zeroes();
+    fputc('"', ASMFIL);
+  } else {
+    fputs("zeroinitializer", ASMFIL);
+  }
+  i8run.open = false;
+}
+
 ISZ_T
 put_skip(ISZ_T old, ISZ_T New)
 {
   ISZ_T amt;
 
   if ((amt = New - old) > 0) {
-    INT i;
-    i = amt;
-    while (i > 32) {
-      fprintf(ASMFIL, "i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 "
-                      "0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 "
-                      "0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0");
-      i -= 32;
-      if (i)
-        fprintf(ASMFIL, ",");
-    }
-    if (i) {
-      while (1) {
-        fprintf(ASMFIL, "i8 0");
-        i--;
-        if (i == 0)
-          break;
-        fprintf(ASMFIL, ",");
-      }
-    }
+    put_zeroes(amt);
   } else {
     assert(amt == 0, "assem.c-put_skip old,new not in sync", New, ERR_Severe);
   }
@@ -160,6 +204,35 @@ write_proc_pointer(SPTR sptr)
   fprintf(ASMFIL, "i8* bitcast(%s* @%s to i8*)", fntype, getsname(sptr));
 }
 
+/* Begin an [N x i8] member unless one is already open. */
+static void
+start_i8_member(ISZ_T i8cnt, int *ptrcnt, char **cptr)
+{
+  if (*ptrcnt || !i8cnt) {
+    if (!first_data)
+      fprintf(ASMFIL, ", ");
+    *cptr = put_next_member(*cptr);
+    put_i8_open();
+    *ptrcnt = 0;
+  }
+}
+
+void
+put_zero_member(ISZ_T *i8cnt, int *ptrcnt, char **cptr)
+{
+  if (*i8cnt) {
+    put_i8_close();
+    fputc(' ', ASMFIL);
+    *i8cnt = 0;
+  }
+  if (!first_data)
+    fprintf(ASMFIL, ", ");
+  *cptr = put_next_member(*cptr);
+  fputs("zeroinitializer ", ASMFIL);
+  *ptrcnt = 0;
+  first_data = 0;
+}
+
 void
 emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
           ISZ_T loc_base, ISZ_T *i8cnt, int *ptrcnt, char **cptr)
@@ -173,7 +246,6 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
   char *initstr = NULL;
   DINIT_REC *item;
   area = LLVM_LONGTERM_AREA;
-  const ISZ_T orig_tconval = tconval;
 
   switch ((int)tdtype) {
   case 0: /* alignment record */
@@ -191,21 +263,7 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
       fprintf(gbl.dbgfil, "emit_init:0 first_data:%d i8cnt:%ld ptrcnt:%d\n",
               first_data, *i8cnt, *ptrcnt);
     }
-    if (*ptrcnt) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-      *cptr = put_next_member(*cptr);
-      fprintf(ASMFIL, "[" /*]*/);
-      *ptrcnt = 0;
-    } else if (!(*i8cnt)) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-      *cptr = put_next_member(*cptr);
-      fprintf(ASMFIL, "[" /*]*/);
-    } else if (*i8cnt) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-    }
+    start_i8_member(*i8cnt, ptrcnt, cptr);
     *i8cnt = *i8cnt + put_skip(*addr, ALIGN(*addr, tconval));
     *addr = ALIGN(*addr, tconval);
     first_data = 0;
@@ -220,21 +278,12 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
               "emit_init:DINIT_ZEROES first_data:%d i8cnt:%ld ptrcnt:%d\n",
               first_data, *i8cnt, *ptrcnt);
     }
-    if (*ptrcnt) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-      *cptr = put_next_member(*cptr);
-      fprintf(ASMFIL, "[" /*]*/);
-      *ptrcnt = 0;
-    } else if (!(*i8cnt)) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-      *cptr = put_next_member(*cptr);
-      fprintf(ASMFIL, "[" /*]*/);
-    } else if (*i8cnt) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
+    if (tconval >= ZERO_MEMBER_MIN) {
+      put_zero_member(i8cnt, ptrcnt, cptr);
+      *addr += tconval;
+      break;
     }
+    start_i8_member(*i8cnt, ptrcnt, cptr);
     put_zeroes((int)tconval);
     *i8cnt = *i8cnt + ((int)tconval);
     *addr += tconval;
@@ -243,7 +292,8 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
 #ifdef DINIT_PROC
   case DINIT_PROC:
     if (*i8cnt) {
-      fprintf(ASMFIL, /*[*/ "] ");
+      put_i8_close();
+      fprintf(ASMFIL, " ");
       *i8cnt = 0;
     }
     if (!first_data) {
@@ -267,13 +317,11 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
     }
 
     if (skip_size) { /* if *i8cnt - just add to the end */
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
       if (*i8cnt) {
-        *i8cnt = put_skip(*addr, ALIGN(*addr, al));
-        *i8cnt = 0;
-        fprintf(ASMFIL, /*[*/ "], ");
-      } else if (*ptrcnt || !(*i8cnt)) {
+        put_skip(*addr, ALIGN(*addr, al));
+      } else {
+        if (!first_data)
+          fprintf(ASMFIL, ", ");
 #ifdef OMP_OFFLOAD_LLVM
         // TODO ompaccel. Hackery for TGT structs. It must be fixed later.
         if (flg.omptarget)
@@ -281,12 +329,15 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
         else
 #endif
           *cptr = put_next_member(*cptr);
-        fprintf(ASMFIL, "[" /*]*/);
-        *i8cnt = put_skip(*addr, ALIGN(*addr, al));
-        fprintf(ASMFIL, /*[*/ "], ");
+        put_i8_open();
+        put_skip(*addr, ALIGN(*addr, al));
       }
+      put_i8_close();
+      fprintf(ASMFIL, ", ");
+      *i8cnt = 0;
     } else if (*i8cnt) {
-      fprintf(ASMFIL, /*[*/ "], ");
+      put_i8_close();
+      fprintf(ASMFIL, ", ");
       *i8cnt = 0;
     } else if (!first_data)
       fprintf(ASMFIL, ", ");
@@ -325,21 +376,12 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
               "emit_init:DINIT_OFFSET first_data:%d i8cnt:%ld ptrcnt:%d\n",
               first_data, *i8cnt, *ptrcnt);
     }
-    if (*ptrcnt) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-      *cptr = put_next_member(*cptr);
-      fprintf(ASMFIL, "[" /*]*/);
-      *ptrcnt = 0;
-    } else if (!(*i8cnt)) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-      *cptr = put_next_member(*cptr);
-      fprintf(ASMFIL, "[" /*]*/);
-    } else if (*i8cnt) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
+    if (skip_size >= ZERO_MEMBER_MIN) {
+      put_zero_member(i8cnt, ptrcnt, cptr);
+      *addr = tconval + loc_base;
+      break;
     }
+    start_i8_member(*i8cnt, ptrcnt, cptr);
     *i8cnt = *i8cnt + put_skip(*addr, tconval + loc_base);
     *addr = tconval + loc_base;
     first_data = 0;
@@ -362,34 +404,18 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
               "emit_init:DINIT_STRING first_data:%d i8cnt:%ld ptrcnt:%d\n",
               first_data, *i8cnt, *ptrcnt);
     }
-    if (*ptrcnt) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-      *cptr = put_next_member(*cptr);
-      fprintf(ASMFIL, "[" /*]*/);
-      *ptrcnt = 0;
-    } else if (!(*i8cnt)) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-      *cptr = put_next_member(*cptr);
-      fprintf(ASMFIL, "[" /*]*/);
-    } else if (*i8cnt) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-    }
+    start_i8_member(*i8cnt, ptrcnt, cptr);
 
     /* Output the data */
     *i8cnt += tconval;
     while (tconval > 0) {
-      if (tconval != orig_tconval)
-        fprintf(ASMFIL, ", ");
       if (tconval > 32) {
         dinit_read_string(32, str);
-        put_string_n(str, 32, 0);
+        put_string_n(str, 32);
         tconval -= 32;
       } else {
         dinit_read_string(tconval, str);
-        put_string_n(str, tconval, 0);
+        put_string_n(str, tconval);
         tconval = 0;
       }
     }
@@ -402,10 +428,7 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
     size_of_item = size_of(tdtype);
 
     if (*repeat_cnt > 1) {
-      /* TO DO: We may be able to optimize this with zeroinitializer
-       * if all i8 before and after this are all zero.
-       *
-       */
+      /* a repeated zero is written as a single run of zero bytes */
       switch (DTY(tdtype)) {
       case TY_INT8:
       case TY_LOG8:
@@ -459,21 +482,7 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
     }
     do {
       if (DTY(tdtype) != TY_PTR && DTY(tdtype) != TY_STRUCT) {
-        if (*ptrcnt) {
-          if (!first_data)
-            fprintf(ASMFIL, ", ");
-          *cptr = put_next_member(*cptr);
-          fprintf(ASMFIL, " [" /*]*/);
-          *ptrcnt = 0;
-        } else if (!(*i8cnt)) {
-          if (!first_data)
-            fprintf(ASMFIL, ", ");
-          *cptr = put_next_member(*cptr);
-          fprintf(ASMFIL, " [" /*]*/);
-        } else if (*i8cnt) {
-          if (!first_data)
-            fprintf(ASMFIL, ", ");
-        }
+        start_i8_member(*i8cnt, ptrcnt, cptr);
       }
       switch (DTY(tdtype)) {
       case TY_INT8:
@@ -485,7 +494,6 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
                   first_data, *i8cnt, *ptrcnt);
         }
         put_i32(CONVAL2G(tconval));
-        fprintf(ASMFIL, ", ");
         if (DBGBIT(5, 32)) {
           fprintf(gbl.dbgfil,
                   "emit_init:put_i32 first_data:%d i8cnt:%ld ptrcnt:%d\n",
@@ -566,7 +574,8 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
 
       case TY_PTR:
         if (*i8cnt) {
-          fprintf(ASMFIL, /*[*/ "], ");
+          put_i8_close();
+          fprintf(ASMFIL, ", ");
         } else if (!first_data)
           fprintf(ASMFIL, ", ");
         *ptrcnt = *ptrcnt + 1;
@@ -594,7 +603,7 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
                   first_data, *i8cnt, *ptrcnt);
         }
         put_string_n(stb.n_base + CONVAL1G((int)tconval),
-                     DTY(DTYPEG((int)tconval) + 1), 0);
+                     DTY(DTYPEG((int)tconval) + 1));
         break;
 
       case TY_NCHAR:
@@ -611,33 +620,21 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
 #ifdef LONG_DOUBLE_FLOAT128
       case TY_X87:
         put_r8(CONVAL1G(tconval), putval);
-        fputc(',', ASMFIL);
         put_r8(CONVAL2G(tconval), putval);
-        fputc(',', ASMFIL);
         put_r8(CONVAL3G(tconval), putval);
-        fputc(',', ASMFIL);
         put_r8(0, putval);
         put_r8(CONVAL4G(tconval), putval);
-        fputc(',', ASMFIL);
         break;
       case TY_X87CMPLX:
         put_r8(CONVAL1G(CONVAL1G(tconval)), putval);
-        fputc(',', ASMFIL);
         put_r8(CONVAL2G(CONVAL1G(tconval)), putval);
-        fputc(',', ASMFIL);
         put_r8(CONVAL3G(CONVAL1G(tconval)), putval);
-        fputc(',', ASMFIL);
         put_r8(CONVAL4G(CONVAL1G(tconval)), putval);
-        fputc(',', ASMFIL);
         put_r8(0, putval);
         put_r8(CONVAL1G(CONVAL2G(tconval)), putval);
-        fputc(',', ASMFIL);
         put_r8(CONVAL2G(CONVAL2G(tconval)), putval);
-        fputc(',', ASMFIL);
         put_r8(CONVAL3G(CONVAL2G(tconval)), putval);
-        fputc(',', ASMFIL);
         put_r8(CONVAL4G(CONVAL2G(tconval)), putval);
-        fputc(',', ASMFIL);
         put_r8(0, putval);
         break;
 #endif /* LONG_DOUBLE_FLOAT128 */
@@ -655,21 +652,7 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
     *repeat_cnt = 1;
     break;
   do_zeroes:
-    if (*ptrcnt) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-      *cptr = put_next_member(*cptr);
-      fprintf(ASMFIL, " [" /*]*/);
-      *ptrcnt = 0;
-    } else if (!(*i8cnt)) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-      *cptr = put_next_member(*cptr);
-      fprintf(ASMFIL, " [" /*]*/);
-    } else if (*i8cnt) {
-      if (!first_data)
-        fprintf(ASMFIL, ", ");
-    }
+    start_i8_member(*i8cnt, ptrcnt, cptr);
     if (DBGBIT(5, 32)) {
       fprintf(gbl.dbgfil,
               "emit_init:put_zeroes at end first_data:%d i8cnt:%ld ptrcnt:%d\n",
@@ -684,89 +667,51 @@ emit_init(DTYPE tdtype, ISZ_T tconval, ISZ_T *addr, ISZ_T *repeat_cnt,
   }
 }
 
+/* A zero-length string still takes one byte. */
 void
-put_string_n(char *p, ISZ_T len, int size)
+put_string_n(char *p, ISZ_T len)
 {
-  int n;
-  char ch;
-  char *ptrch = "i8";
-  char chnm[10];
-
-  /* check for wide string - size is given by caller */
-  if (size) {
-    snprintf(chnm, sizeof(chnm), "i%d", size);
-    ptrch = chnm;
-  }
-
   if (len == 0) {
-    fprintf(ASMFIL, "%s 0", ptrch);
+    put_byte(0);
     return;
   }
-  n = 0;
   while (len--) {
-    ch = *p;
-    fprintf(ASMFIL, "%s %u", ptrch, ch & 0xff);
-    if (len)
-      fprintf(ASMFIL, ",");
+    put_byte(*p);
     ++p;
-    ++n;
   }
 } /* put_string_n */
 
 static void
 put_ncharstring_n(char *p, ISZ_T len, int size_of_char)
 {
-  int n, bytes;
-  char ch;
-  char *ptrch = "i8";
-  char chnm[10];
+  int bytes;
   union {
     char a[2];
     short i;
   } chtmp;
 
   if (len == 0) {
-    fprintf(ASMFIL, "%s 0,", ptrch);
-    fprintf(ASMFIL, "%s 0", ptrch);
+    put_byte(0);
+    put_byte(0);
     return;
   }
-  n = 0;
 
   while (len > 0) {
     int val = kanji_char((unsigned char *)p, len, &bytes);
     p += bytes;
     len -= bytes;
     chtmp.i = val;
-    fprintf(ASMFIL, "%s %u, ", ptrch, chtmp.a[0] & 0xff);
-    fprintf(ASMFIL, "%s %u", ptrch, chtmp.a[1] & 0xff);
-    if (len)
-      fprintf(ASMFIL, ",");
+    put_byte(chtmp.a[0]);
+    put_byte(chtmp.a[1]);
   }
 
-} /* put_string_n */
+} /* put_ncharstring_n */
 
 static void
 put_zeroes(ISZ_T len)
 {
-  ISZ_T i;
-  i = len;
-  while (i > 32) {
-    fprintf(ASMFIL, "i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 "
-                    "0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 "
-                    "0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0,i8 0");
-    i -= 32;
-    if (i)
-      fprintf(ASMFIL, ",");
-  }
-  if (i) {
-    while (1) {
-      fprintf(ASMFIL, "i8 0");
-      i--;
-      if (i == 0)
-        break;
-      fprintf(ASMFIL, ",");
-    }
-  }
+  assert(i8run.open, "put_zeroes: no member open", len, ERR_Severe);
+  i8run.zeroes += len;
 }
 
 static void
@@ -788,35 +733,28 @@ put_zeroes_bytype(ISZ_T len, char *ttype, char *initval)
 static void
 put_i8(int val)
 {
-  int i;
   i8bit.i8 = (short)val;
-  fprintf(ASMFIL, "i8 %u", i8bit.byte[0] & 0xff);
+  put_byte(i8bit.byte[0]);
 }
 
-/* write:  i8 x1, i8 x2 */
+/* write the 2 bytes of val */
 static void
 put_i16(int val)
 {
   int i;
   i16bit.i16 = val;
-  for (i = 0; i < 2; i++) {
-    fprintf(ASMFIL, "i8 %u", i16bit.byte[i] & 0xff);
-    if (i < 1)
-      fprintf(ASMFIL, ",");
-  }
+  for (i = 0; i < 2; i++)
+    put_byte(i16bit.byte[i]);
 }
 
-/* write:  i8 0x?, i8 0x?, i8 0x?, i8 0x? */
+/* write the 4 bytes of val */
 void
 put_i32(int val)
 {
   int i;
   i32bit.i32 = val;
-  for (i = 0; i < 4; i++) {
-    fprintf(ASMFIL, "i8 %u", i32bit.byte[i] & 0xff);
-    if (i < 3)
-      fprintf(ASMFIL, ", ");
-  }
+  for (i = 0; i < 4; i++)
+    put_byte(i32bit.byte[i]);
 }
 
 void
@@ -843,17 +781,14 @@ put_int8(INT val)
   fprintf(ASMFIL, "i64 %lu", (unsigned long)val);
 }
 
-/* write:  i8 0x?, i8 0x?, i8 0x?, i8 0x? */
+/* write the 4 bytes of val */
 static void
 put_r4(INT val)
 {
   int i;
   i32bit.i32 = val;
-  for (i = 0; i < 4; i++) {
-    fprintf(ASMFIL, "i8 %u", i32bit.byte[i] & 0xff);
-    if (i < 3)
-      fprintf(ASMFIL, ",");
-  }
+  for (i = 0; i < 4; i++)
+    put_byte(i32bit.byte[i]);
 }
 
 static void
@@ -906,11 +841,9 @@ put_r8(int sptr, int putval)
   num[1] = CONVAL2G(sptr);
   if (flg.endian) {
     put_r4(num[0]);
-    fprintf(ASMFIL, ",");
     put_r4(num[1]);
   } else {
     put_r4(num[1]);
-    fprintf(ASMFIL, ",");
     put_r4(num[0]);
   }
 }
@@ -919,7 +852,6 @@ static void
 put_cmplx_n(int sptr, int putval)
 {
   put_r4(CONVAL1G(sptr));
-  fprintf(ASMFIL, ",");
   put_r4(CONVAL2G(sptr));
 }
 
@@ -947,7 +879,6 @@ static void
 put_dcmplx_n(int sptr, int putval)
 {
   put_r8((int)CONVAL1G(sptr), putval);
-  fprintf(ASMFIL, ",");
   put_r8((int)CONVAL2G(sptr), putval);
 }
 
@@ -13,6 +13,31 @@
 #include "symtab.h"
 #include "ll_structure.h"
 
+/**
+   \brief Zero bytes in a run at least this long are given an [N x i8]
+   member of their own, initialized with zeroinitializer
+ */
+#define ZERO_MEMBER_MIN 64
+
+/**
+   \brief Begin writing the bytes of an [N x i8] initializer member
+ */
+void put_i8_open(void);
+
+/**
+   \brief Finish the member begun by put_i8_open()
+
+   Its bytes are written as a string constant, or as zeroinitializer if
+   they are all zero.
+ */
+void put_i8_close(void);
+
+/**
+   \brief Close the [N x i8] member being written, if any, and write a
+   member of zero bytes as zeroinitializer
+ */
+void put_zero_member(ISZ_T *i8cnt, int *ptrcnt, char **cptr);
+
 /**
    \brief ...
  */
@@ -97,6 +122,6 @@ void put_short(int val);
 /**
    \brief ...
  */
-void put_string_n(char *p, ISZ_T len, int size);
+void put_string_n(char *p, ISZ_T len);
 
 #endif // LLASSEM_COMMON_H_
@@ -1766,7 +1766,7 @@ print_space(int num)
   int i;
 
   for (i = 0; i < num; i++)
-    fputc(' ', LLVMFIL);
+    ll_putc(LLVMFIL, ' ');
 }
 
 void
@@ -1785,9 +1785,8 @@ void
 print_line(char *ln)
 {
   if (ln != NULL)
-    fprintf(LLVMFIL, "%s\n", ln);
-  else
-    fprintf(LLVMFIL, "\n");
+    ll_puts(LLVMFIL, ln);
+  ll_putc(LLVMFIL, '\n');
 }
 
 /**
@@ -1815,7 +1814,7 @@ void
 print_token(const char *tk)
 {
   assert(tk, "print_token(): missing token", 0, ERR_Fatal);
-  fprintf(LLVMFIL, "%s", tk);
+  ll_puts(LLVMFIL, tk);
 }
 
 /**
@@ -1834,7 +1833,7 @@ print_token_tobuf(char *tk, char *buf)
 void
 print_nl(void)
 {
-  fprintf(LLVMFIL, "\n");
+  ll_putc(LLVMFIL, '\n');
 }
 
 void
@@ -1851,15 +1850,14 @@ print_nl_tobuf(char *buf)
 void
 print_dbg_line_no_comma(LL_MDRef md)
 {
-  char buf[32];
-  snprintf(buf, 32, " !dbg !%u", LL_MDREF_value(md));
-  print_token(buf);
+  ll_puts(LLVMFIL, " !dbg !");
+  ll_putu(LLVMFIL, LL_MDREF_value(md));
 }
 
 void
 print_dbg_line(LL_MDRef md)
 {
-  print_token(",");
+  ll_putc(LLVMFIL, ',');
   print_dbg_line_no_comma(md);
 }
 
@@ -2038,10 +2036,13 @@ write_constant_value(int sptr, LL_Type *type, INT conval0, INT conval1,
       num[0] = conval1;
     }
     if (ll_type_bytes(type) <= 4) {
-      fprintf(LLVMFIL, uns ? "%lu" : "%ld", (long)num[1]);
+      if (uns)
+        ll_putu(LLVMFIL, (unsigned long)(long)num[1]);
+      else
+        ll_puti(LLVMFIL, (long)num[1]);
     } else {
       ui64toax(num, b, 22, uns, 10);
-      fprintf(LLVMFIL, "%s", b);
+      ll_puts(LLVMFIL, b);
     }
     return;
 
@@ -2062,7 +2063,7 @@ write_constant_value(int sptr, LL_Type *type, INT conval0, INT conval1,
     else if (num[0] == 0x80000000 && num[1] == 0x00000000)
       sprintf(d, "-0.00000000e+00");
     /* remember to make room for /0 */
-    fprintf(LLVMFIL, "%s", d);
+    ll_puts(LLVMFIL, d);
     return;
 
   case LL_FLOAT:
@@ -2522,8 +2523,6 @@ init_metadata_index(TMPS *t)
 void
 print_metadata_name(TMPS *t)
 {
-  char tmp[50];
-
   DBGTRACEIN1(" TMPS* %p", t)
 
   if (!t->id)
@@ -2531,8 +2530,8 @@ print_metadata_name(TMPS *t)
   if (t->id < 0) {
     print_token(t->info.string);
   } else {
-    sprintf(tmp, "!%d", t->id - 1);
-    print_token(tmp);
+    ll_putc(LLVMFIL, '!');
+    ll_puti(LLVMFIL, t->id - 1);
   }
   DBGTRACEOUT("")
 } /* print_metadata_name */
@@ -31,6 +31,7 @@
 #include "llassem.h"
 #include "cgllvm.h"
 #include "outliner.h"
+#include "ll_write.h"
 #if !defined(TARGET_WIN)
 #include <unistd.h>
 #endif
@@ -42,10 +43,16 @@
 #include "dwarf2.h"
 #include "direct.h"
 #include "expand.h"
+#include "iliutil.h"
 #include "scope.h"
 #include <stdbool.h>
 #include "flang/ArgParser/arg_parser.h"
 #include "dtypeutl.h"
+#include "bih.h"
+#include "ilt.h"
+#include "nme.h"
+#include "cgmain.h"
+#include "phasestat.h"
 
 static bool process_input(char *argv0, bool *need_cuda_constructor);
 
@@ -64,6 +71,7 @@ extern int errno;
 /* contents of this file:  */
 
 static void reptime(void);
+static void record_phase(const char *phase);
 static void init(int, char *[]);
 static void reinit(void);
 
@@ -92,6 +100,7 @@ static char *who[] = {"init", "import",   "expand", "", "",
 static INT xtimes[_N_WHO];
 static char *cmdline = NULL;
 static char *ccff_filename = NULL;
+static char *phasestat_file = NULL;
 #include "ccffinfo.h"
 
 #if DEBUG
@@ -115,7 +124,7 @@ static char *dbg_feature = "flang";
 
 static int ipa_import_mode = 0;
 
-#define DUMP(a)
+#define DUMP(a) record_phase(a)
 
 #define NO_FLEXLM
 
@@ -193,6 +202,7 @@ process_input(char *argv0, bool *need_cuda_constructor)
       interr("main: malloc_verify failsB", errno, ERR_Fatal);
 #endif
   xtimes[0] += get_rutime();
+  record_phase("init");
   /* don't increment if it is outlined function because it
    * uses STATICS/BSS from host routine.
    */
@@ -329,6 +339,7 @@ process_input(char *argv0, bool *need_cuda_constructor)
     TR("F90 ASSEMBLER begins\n");
     assemble();
     xtimes[6] += get_rutime();
+    record_phase("assemble");
     upper_save_syminfo();
   }
   if (DBGBIT(5, 4))
@@ -358,6 +369,7 @@ process_input(char *argv0, bool *need_cuda_constructor)
   if (flg.xref) {
     xref(); /* write cross reference map */
     xtimes[7] += get_rutime();
+    record_phase("xref");
   }
   (void)summary(false, 0);
   cg_llvm_fnend();
@@ -383,6 +395,7 @@ main(int argc, char *argv[])
 
   get_rutime();
   init(argc, argv);
+  phasestat_init(phasestat_file, "flang2", gbl.file_name);
 
   saveoptflag = flg.opt;
   savevectflag = flg.vect;
@@ -451,6 +464,23 @@ main(int argc, char *argv[])
   return 0; /* never reached */
 }
 
+/** \brief Write a timing report line to the listing or the debug file */
+static void
+reptime_line(char *buf)
+{
+  if (flg.code || flg.list || flg.xref)
+    list_line(buf);
+  else if (gbl.dbgfil)
+    fprintf(gbl.dbgfil, "%s\n", buf);
+}
+
+/** \brief Write a timing report line to stderr */
+static void
+reptime_stderr_line(char *buf)
+{
+  fprintf(stderr, "%s\n", buf);
+}
+
 static void
 reptime()
 {
@@ -478,18 +508,14 @@ reptime()
       prct = tmp / total;
       sprintf(buf, "    %-10.10s %15d millisecs %5d%%", who[i], xtimes[i],
               prct);
-      if (flg.code || flg.list || flg.xref)
-        list_line(buf);
-      else if (gbl.dbgfil)
-        fprintf(gbl.dbgfil, "%s\n", buf);
+      reptime_line(buf);
     }
   }
 
   sprintf(buf, "    Total time %15d millisecs", total);
-  if (flg.code || flg.list || flg.xref) {
-    list_line(buf);
-  } else if (gbl.dbgfil)
-    fprintf(gbl.dbgfil, "%s\n", buf);
+  reptime_line(buf);
+  ili_hash_report(reptime_line);
+  ag_hash_report(reptime_line);
 
 xbitcheck:
   if (!XBIT(0, 1))
@@ -507,6 +533,26 @@ xbitcheck:
   }
   sprintf(buf, "    Total time %15d millisecs", total);
   fprintf(stderr, "%s\n", buf);
+  ili_hash_report(reptime_stderr_line);
+  ag_hash_report(reptime_stderr_line);
+}
+
+/** \brief Append the statistics for a phase that has just finished to the
+ * -phasestats file
+ */
+static void
+record_phase(const char *phase)
+{
+  if (!phasestat_enabled())
+    return;
+  phasestat_table("sym", stb.stg_avail);
+  phasestat_table("dt", stb.dt.stg_avail);
+  phasestat_table("ili", ilib.stg_avail);
+  phasestat_table("ilt", iltb.stg_avail);
+  phasestat_table("bih", bihb.stg_avail);
+  phasestat_table("nme", nmeb.stg_avail);
+  phasestat_table("llvm_instrs", cg_instr_count());
+  phasestat_record(phase, gbl.currsub ? SYMNAME(gbl.currsub) : NULL);
 }
 
 /** \brief Dump symbols
@@ -670,6 +716,7 @@ init(int argc, char *argv[])
   register_boolean_arg(arg_parser, "recursive", &flg.recursive, false);
   register_integer_arg(arg_parser, "vect", &vect_val, 0);
   register_string_arg(arg_parser, "cmdline", &cmdline, NULL);
+  register_string_arg(arg_parser, "phasestats", &phasestat_file, NULL);
   register_boolean_arg(arg_parser, "debug", &flg.debug, false);
 
   /* Run argument parser */
@@ -849,6 +896,7 @@ do_curr_file:
     }
     if ((gbl.asmfil = fopen(asmfile, "w")) == NULL)
       errfatal((error_code_t)9);
+    ll_setup_output_file(gbl.asmfil);
   } else /* do this for compilers which write asm code to stdout */
     gbl.asmfil = stdout;
 
@@ -980,6 +1028,7 @@ finish()
   freearea(8); /* temporary filenames and pathnames space  */
   if (phase_dump_map != NULL)
     destroy_action_map(&phase_dump_map);
+  phasestat_fini();
   free_getitem_p();
   if (maxfilsev >= 3)
     exit(1);
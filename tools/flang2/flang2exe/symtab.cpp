@@ -426,6 +426,82 @@ get_acon3(SPTR sym, ISZ_T off, DTYPE dtype)
   return sptr;
 }
 
+/* Recompute the hash value under which sptr was entered: constants are
+ * hashed by value the way getcon(), get_acon3(), get_vcon() and
+ * getstring() do it, everything else by name.
+ */
+static int
+sym_hash_value(SPTR sptr)
+{
+  int hashval;
+  INT value[2];
+  DTYPE dtype;
+  const char *np;
+
+  if (STYPEG(sptr) == ST_CONST) {
+    dtype = DTYPEG(sptr);
+    if (DTY(dtype) == TY_CHAR) {
+      HASH_STR(hashval, stb.n_base + CONVAL1G(sptr), DTyCharLength(dtype));
+      return hashval;
+    }
+    if (DTY(dtype) == TY_VECT)
+      return HASH_CON((&stb.dt.stg_base[dtype]));
+    value[0] = CONVAL1G(sptr);
+    value[1] = CONVAL2G(sptr);
+    return HASH_CON(value);
+  }
+  np = SYMNAME(sptr);
+  HASH_ID(hashval, np, strlen(np));
+  return hashval;
+}
+
+/**
+   \brief Give stb.hashtb enough buckets for nsyms symbols.
+
+   The table is rebuilt with about twice as many buckets once the average
+   chain would get longer than two.  Every hash value in use refers to the
+   old size, so callers must not hold one; upper() calls this before it
+   reads the symbols of a routine.
+ */
+void
+grow_sym_hash(int nsyms)
+{
+  SPTR *old, *list;
+  int oldsz, n, i, hashval;
+  SPTR sptr;
+
+  if (nsyms <= 2 * stb.hashsz)
+    return;
+  old = stb.hashtb;
+  oldsz = stb.hashsz;
+  n = 0;
+  NEW(list, SPTR, stb.stg_avail);
+  for (i = 0; i <= oldsz; ++i) {
+    for (sptr = old[i]; sptr != SPTR_NULL; sptr = HASHLKG(sptr)) {
+      assert(n < (int)stb.stg_avail, "grow_sym_hash: hash chains too long", i,
+             ERR_Fatal);
+      list[n++] = sptr;
+    }
+  }
+  while (stb.hashsz < nsyms)
+    stb.hashsz = 2 * stb.hashsz + 1;
+  NEW(stb.hashtb, SPTR, stb.hashsz + 1);
+  BZERO(stb.hashtb, SPTR, stb.hashsz + 1);
+  /* reinsert from the back so each chain keeps its order */
+  while (n > 0) {
+    sptr = list[--n];
+    hashval = sym_hash_value(sptr);
+    LINKSYM(sptr, hashval);
+  }
+  FREE(list);
+  FREE(old);
+#if DEBUG
+  if (DBGBIT(5, 1024))
+    fprintf(gbl.dbgfil, "grow_sym_hash: %d buckets -> %d for %d symbols\n",
+            oldsz, stb.hashsz, nsyms);
+#endif
+}
+
 SPTR
 get_vcon(INT *value, DTYPE dtype)
 {
@@ -1850,7 +1926,7 @@ pop_scope(void)
   if (DBGBIT(5, 1024))
     fprintf(gbl.dbgfil, "pop_scope(): scope %d\n", stb.curr_scope);
 #endif
-  for (i = 0; i < HASHSIZE; i++)
+  for (i = 0; i < stb.hashsz; i++)
     for (sptr = stb.hashtb[i], j = 0; sptr; sptr = HASHLKG(sptr))
       if ((int)SCOPEG(sptr) >= stb.curr_scope) {
 #if DEBUG
@@ -81,6 +81,7 @@ static DTYPE create_threadprivate_dtype(void);
 static int getnamelen(void);
 static char *getname(void);
 static int getoperand(const char *optype, char letter);
+static int getvarint(void);
 
 static void read_ilm(void);
 static void read_label(void);
@@ -350,6 +351,9 @@ static int tpcount;
 static DTYPE threadprivate_dtype;
 static int *ilmxref;
 static int ilmxrefsize, origilmavl;
+/* operations named so far by ILM_BINARY records, by their number - 1 */
+static int *ilmops;
+static int ilmopsize, ilmopavl;
 
 #ifdef __cplusplus
 inline SPTR getSptrVal(const char *s) {
@@ -477,6 +481,8 @@ upper(int stb_processing)
   endilmfile = read_line();
   symbolcount = getval("Symbols");
   oldsymbolcount = stb.stg_avail - 1;
+  /* size the symbol hash table before any of the new symbols is entered */
+  grow_sym_hash(stb.stg_avail + symbolcount);
   NEW(symbolxref, SPTR, symbolcount + 1);
   BZERO(symbolxref, SPTR, symbolcount + 1);
 
@@ -490,6 +496,9 @@ upper(int stb_processing)
   NEW(ilmxref, int, ilmxrefsize);
   BZERO(ilmxref, int, ilmxrefsize);
   origilmavl = 0;
+  ilmopsize = 100;
+  NEW(ilmops, int, ilmopsize);
+  ilmopavl = 0;
 
   endilmfile = read_line();
   size = getval("BSS");
@@ -621,6 +630,7 @@ upper(int stb_processing)
       endilmfile = 1;
       break;
     case 'i':
+    case ILM_BINARY:
       /* ilm */
       read_ilm();
       break;
@@ -670,6 +680,7 @@ do_pastilm:
     FREE(stack);
   FREE(datatypexref);
   FREE(ilmxref);
+  FREE(ilmops);
 
   if (gbl.internal) {
     /* must be done here before freeing symbolxref and saved_symbolxref */
@@ -3716,9 +3727,12 @@ fix_symbol(void)
           const int newMid = symbolxref[midnum];
           MIDNUMP(sptr, newMid);
 #ifdef REVMIDLNKP
-          if (POINTERG(sptr) && newMid) {
-            assert(!REVMIDLNKG(newMid), "REVMIDLNK already set", newMid,
-                   ERR_Fatal);
+          /* a pointer array shares its pointer only with the compiler
+           * created CONTIGUOUS clones of it; link back to the array */
+          if (POINTERG(sptr) && newMid &&
+              !(CCSYMG(sptr) && REVMIDLNKG(newMid))) {
+            assert(!REVMIDLNKG(newMid) || CCSYMG(REVMIDLNKG(newMid)),
+                   "REVMIDLNK already set", newMid, ERR_Fatal);
             REVMIDLNKP(newMid, sptr);
           }
 #endif
@@ -4156,17 +4170,22 @@ getoperand(const char *optype, char letter)
   }
 
   ++pos;
-  val = 0;
-  neg = 1;
-  if (line[pos] == '-') {
-    ++pos;
-    neg = -1;
-  }
-  while (line[pos] >= '0' && line[pos] <= '9') {
-    val = val * 10 + (line[pos] - '0');
-    ++pos;
+  if (line[0] == ILM_BINARY) {
+    val = getvarint();
+    val = (int)((unsigned)val >> 1) ^ -(val & 1); /* zigzag */
+  } else {
+    val = 0;
+    neg = 1;
+    if (line[pos] == '-') {
+      ++pos;
+      neg = -1;
+    }
+    while (line[pos] >= '0' && line[pos] <= '9') {
+      val = val * 10 + (line[pos] - '0');
+      ++pos;
+    }
+    val *= neg;
   }
-  val *= neg;
   switch (letter) {
   case chsym:
     if (val == 0)
@@ -4208,13 +4227,44 @@ getoperand(const char *optype, char letter)
   return 0;
 } /* getoperand */
 
+/* look up an operation name, or return -1 for end of statement and -2 for
+ * an unimplemented operation */
+static int
+findoperation(const char *p)
+{
+  int hi, lo;
+
+  if (strncmp(p, "---", 3) == 0)
+    return -1;
+  if (strncmp(p, "--", 2) == 0)
+    return -2;
+  /* binary search */
+  hi = NUMOPERATIONS - 1;
+  lo = 0;
+  while (lo <= hi) {
+    int mid, compare;
+    mid = (hi + lo) / 2;
+    compare = strcmp(p, info[mid].name);
+    if (compare == 0)
+      return mid;
+    if (compare < 0) {
+      hi = mid - 1;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  fprintf(stderr, "ILM file line %d: unknown operation: %s\n", ilmlinenum, p);
+  ++errors;
+  return -5;
+} /* findoperation */
+
 static int
 getoperation(void)
 {
   char ch;
   char *p;
   int len;
-  int hi, lo;
+  int op;
 
   if (endilmfile) {
     fprintf(stderr, "ILM file: looking past end-of-file for operation\n");
@@ -4247,40 +4297,78 @@ getoperation(void)
     ch = line[pos];
   }
   line[pos] = '\0';
-  /* binary search */
-  hi = NUMOPERATIONS - 1;
-  lo = 0;
-  while (lo <= hi) {
-    int mid, compare;
-    mid = (hi + lo) / 2;
-    compare = strcmp(p, info[mid].name);
-    if (compare == 0) {
-      line[pos] = ch;
-      return mid;
-    }
-    if (compare < 0) {
-      hi = mid - 1;
-    } else {
-      lo = mid + 1;
-    }
-  }
+  op = findoperation(p);
   line[pos] = ch;
-  fprintf(stderr, "ILM file line %d: unknown operation: %s\n", ilmlinenum, p);
-  ++errors;
-  return -5;
+  return op;
 } /* getoperation */
 
+/* read an ILM_VARINT from an ILM_BINARY record */
+static int
+getvarint(void)
+{
+  unsigned val = 0;
+  int shift = 0;
+  unsigned char ch;
+
+  for (ch = line[pos]; ch & ILM_VARINT_MORE; ch = line[++pos]) {
+    val |= (unsigned)(ch & 0x7f) << shift;
+    shift += 7;
+  }
+  if (!(ch & ILM_VARINT_LAST)) {
+    fprintf(stderr, "ILM file line %d: bad binary ILM record\n", ilmlinenum);
+    ++errors;
+    return 0;
+  }
+  val |= (unsigned)(ch & (ILM_VARINT_LAST - 1)) << shift;
+  ++pos;
+  return val;
+} /* getvarint */
+
+/* get the operation of an ILM_BINARY record, entering a new name into ilmops
+ */
+static int
+getbinoperation(void)
+{
+  int n, len, op;
+  char ch;
+
+  n = getvarint();
+  if (n > 0) {
+    if (n > ilmopavl) {
+      fprintf(stderr, "ILM file line %d: unknown operation number %d\n",
+              ilmlinenum, n);
+      ++errors;
+      return -5;
+    }
+    return ilmops[n - 1];
+  }
+  len = getvarint();
+  ch = line[pos + len];
+  line[pos + len] = '\0';
+  op = findoperation(line + pos);
+  line[pos + len] = ch;
+  pos += len;
+  NEED(ilmopavl + 1, ilmops, int, ilmopsize, ilmopsize * 2);
+  ilmops[ilmopavl++] = op;
+  return op;
+} /* getbinoperation */
+
 /* read one line from the ILM file */
 static void
 read_ilm(void)
 {
   int ilm, op, numoperands, i, opc;
-  ilm = getilm();
-  if (line[pos] == ':') {
-    ++pos;
+  if (line[0] == ILM_BINARY) {
+    pos = 1;
+    ilm = origilmavl;
+    op = getbinoperation();
+  } else {
+    ilm = getilm();
+    if (line[pos] == ':') {
+      ++pos;
+    }
+    op = getoperation();
   }
-
-  op = getoperation();
   numoperands = 0;
 
   if (op >= 0 && info[op].ilmtype == IM_BOS) {
@@ -136,13 +136,24 @@
  *              pass elemental field for subprogram when emitting ST_ENTRY.
  *
  *              For ST_PROC, receive IS_PROC_PTR_IFACE flag.
+ *
+ *              -- 1.56
+ *              All of 1.55 +
+ *              ILM lines may be read as binary records, see ILM_BINARY.
  */
 
 #include "gbldefs.h"
 #include "semant.h"
 
 #define VersionMajor 1
-#define VersionMinor 55
+#define VersionMinor 56
+
+/* ILM lines written by flang1 as binary records; see lower.h there for the
+ * encoding.
+ */
+#define ILM_BINARY '\001'
+#define ILM_VARINT_LAST 0x40
+#define ILM_VARINT_MORE 0x80
 
 /**
    \brief ...
@@ -575,6 +575,11 @@ void symdmp(FILE *dfil, bool full);
  */
 void sym_init(void);
 
+/**
+   \brief Give stb.hashtb enough buckets for nsyms symbols
+ */
+void grow_sym_hash(int nsyms);
+
 #ifdef __cplusplus
 // FIXME - these are hacks to allow addition on DTYPEs
 inline DTYPE operator+=(DTYPE d, int c)
@@ -93,6 +93,37 @@ typedef enum omp_iftype {
   IF_TASKLOOP = (1 << 7),
 } omp_iftype;
 
+/* Reduction items combined by the __kmpc_reduce_nowait protocol.  The
+ * front-end puts the operator in MP_REDUCTIONITEM; the back-end describes
+ * each item to the runtime combiner, _mp_reduce_kmpc() in llcrit.c, with
+ * the word
+ *   (element count << MP_RED_CNT_SHIFT) | (type << MP_RED_TYPE_SHIFT) | op
+ * Logical .AND., .OR. and .NEQV. are the bitwise operators applied to the
+ * canonical .TRUE. and .FALSE. values.
+ *
+ * The runtime does not include compiler headers, so llcrit.c has its own
+ * copy of these values; change both together.
+ */
+#define MP_RED_ADD 1
+#define MP_RED_MUL 2
+#define MP_RED_MAX 3
+#define MP_RED_MIN 4
+#define MP_RED_IAND 5
+#define MP_RED_IOR 6
+#define MP_RED_IEOR 7
+
+#define MP_RED_I1 1
+#define MP_RED_I2 2
+#define MP_RED_I4 3
+#define MP_RED_I8 4
+#define MP_RED_R4 5
+#define MP_RED_R8 6
+#define MP_RED_C8 7
+#define MP_RED_C16 8
+
+#define MP_RED_TYPE_SHIFT 8
+#define MP_RED_CNT_SHIFT 16
+
 /* Keep up to date with pgcplus_omp_cancel_type init_omp()*/
 typedef enum omp_canceltype {
   CANCEL_PARALLEL = 1,
@@ -1724,7 +1724,7 @@ PrintTopHash(void)
     topten[s] = 0;
     toptensize[s] = 0;
   }
-  for (h = 0; h < HASHSIZE + 1; ++h) {
+  for (h = 0; h < stb.hashsz + 1; ++h) {
     s = 0;
     for (sptr = stb.hashtb[h]; sptr > NOSYM; sptr = HASHLKG(sptr))
       ++s;
@@ -1750,7 +1750,8 @@ PrintTopHash(void)
   fprintf(gbl.dbgfil, "Function %d = %s\nTop %d Symbol Hash Table Entries\n %d "
                       "symbols, Hash Size %d, Average length %d:\n",
           gbl.func_count, GBL_CURRFUNC ? SYMNAME(GBL_CURRFUNC) : "", TOP,
-          stb.stg_avail - 1, HASHSIZE + 1, (stb.stg_avail - 1 + HASHSIZE) / HASHSIZE);
+          stb.stg_avail - 1, stb.hashsz + 1,
+          (stb.stg_avail - 1 + stb.hashsz) / stb.hashsz);
   for (s = 0; s < TOP; ++s) {
     fprintf(gbl.dbgfil, " [%2d] %d * %d\n", s + 1, toptensize[s], topten[s]);
   }
@@ -0,0 +1,174 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+/** \file
+    \brief Per-phase compile-time and memory statistics.
+
+    With -phasestats <file>, a compiler appends one JSON object per line
+    to <file> each time a phase of a routine finishes, e.g.
+
+      {"tool":"flang1","source":"a.f90","routine":"sub","phase":"parser",
+       "wall_ms":1.204,"cpu_ms":1.198,"maxrss_kb":20480,
+       "area_bytes":131072,"area_hiwater":262144,
+       "tables":{"sym":1890,"ast":1203}}
+
+    wall_ms and cpu_ms cover the time since the previous record.
+    maxrss_kb is the peak resident set size of the process so far.
+    area_bytes and area_hiwater are the getitem() storage held now and
+    at its peak.  The file is opened for appending, so flang1, flang2
+    and any number of compiles may write to the same file.
+ */
+
+#include "phasestat.h"
+#include "global.h"
+#include "error.h"
+#include <time.h>
+#if !defined(HOST_WIN)
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+#define MAXTABLES 16
+
+static struct {
+  FILE *fd;
+  const char *tool;
+  const char *source;
+  double wall; /* milliseconds, at the previous record */
+  double cpu;  /* milliseconds, at the previous record */
+  int ntables;
+  struct {
+    const char *name;
+    long size;
+  } tables[MAXTABLES];
+} ps;
+
+/* Read the clocks, and the peak resident set size in kilobytes. */
+static void
+get_usage(double *wall, double *cpu, long *maxrss)
+{
+#if !defined(HOST_WIN)
+  struct timespec ts;
+  struct rusage ru;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  *wall = ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+  getrusage(RUSAGE_SELF, &ru);
+  *cpu = (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1e3 +
+         (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e3;
+#if defined(__APPLE__)
+  *maxrss = ru.ru_maxrss / 1024; /* bytes */
+#else
+  *maxrss = ru.ru_maxrss;
+#endif
+#else
+  *wall = *cpu = clock() * 1e3 / CLOCKS_PER_SEC;
+  *maxrss = 0;
+#endif
+}
+
+/* Write s as a JSON string, or null. */
+static void
+put_string(const char *s)
+{
+  if (s == NULL) {
+    fputs("null", ps.fd);
+    return;
+  }
+  putc('"', ps.fd);
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\')
+      fprintf(ps.fd, "\\%c", *s);
+    else if ((unsigned char)*s < ' ')
+      fprintf(ps.fd, "\\u%04x", *s);
+    else
+      putc(*s, ps.fd);
+  }
+  putc('"', ps.fd);
+}
+
+void
+phasestat_init(const char *filename, const char *tool, const char *source)
+{
+  long maxrss;
+
+  if (filename == NULL)
+    return;
+  ps.fd = fopen(filename, "a");
+  if (ps.fd == NULL)
+    errfatal((error_code_t)5);
+  ps.tool = tool;
+  ps.source = source;
+  ps.ntables = 0;
+  get_usage(&ps.wall, &ps.cpu, &maxrss);
+}
+
+bool
+phasestat_enabled(void)
+{
+  return ps.fd != NULL;
+}
+
+void
+phasestat_table(const char *name, long size)
+{
+  if (ps.ntables < MAXTABLES) {
+    ps.tables[ps.ntables].name = name;
+    ps.tables[ps.ntables].size = size;
+    ++ps.ntables;
+  }
+}
+
+void
+phasestat_record(const char *phase, const char *routine)
+{
+  double wall, cpu;
+  long maxrss;
+  size_t held = 0, hiwater = 0;
+  int i;
+
+  if (ps.fd == NULL)
+    return;
+  get_usage(&wall, &cpu, &maxrss);
+#if DEBUG
+  areausage(&held, &hiwater);
+#endif
+  fputs("{\"tool\":", ps.fd);
+  put_string(ps.tool);
+  fputs(",\"source\":", ps.fd);
+  put_string(ps.source);
+  fputs(",\"routine\":", ps.fd);
+  put_string(routine);
+  fputs(",\"phase\":", ps.fd);
+  put_string(phase);
+  fprintf(ps.fd,
+          ",\"wall_ms\":%.3f,\"cpu_ms\":%.3f,\"maxrss_kb\":%ld"
+          ",\"area_bytes\":%lu,\"area_hiwater\":%lu,\"tables\":{",
+          wall - ps.wall, cpu - ps.cpu, maxrss, (unsigned long)held,
+          (unsigned long)hiwater);
+  for (i = 0; i < ps.ntables; ++i) {
+    if (i)
+      putc(',', ps.fd);
+    put_string(ps.tables[i].name);
+    fprintf(ps.fd, ":%ld", ps.tables[i].size);
+  }
+  fputs("}}\n", ps.fd);
+  /* one write per record keeps concurrent compiles from interleaving */
+  fflush(ps.fd);
+  ps.ntables = 0;
+  /* don't charge the time spent writing to the next phase */
+  get_usage(&ps.wall, &ps.cpu, &maxrss);
+}
+
+void
+phasestat_fini(void)
+{
+  if (ps.fd != NULL) {
+    fclose(ps.fd);
+    ps.fd = NULL;
+  }
+}
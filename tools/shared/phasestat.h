@@ -0,0 +1,47 @@
+/*
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef PHASESTAT_H_
+#define PHASESTAT_H_
+
+#include "gbldefs.h"
+#include <stdbool.h>
+
+/**
+   \brief Start appending per-phase statistics to \p filename
+   \param filename  file named by -phasestats; NULL leaves statistics off
+   \param tool      name of the compiler writing the records
+   \param source    name of the source file being compiled
+ */
+void phasestat_init(const char *filename, const char *tool,
+                    const char *source);
+
+/**
+   \brief Is a statistics file open?
+ */
+bool phasestat_enabled(void);
+
+/**
+   \brief Add a table size to the next record
+ */
+void phasestat_table(const char *name, long size);
+
+/**
+   \brief Write the record for a phase that has just finished
+   \param phase    name of the phase
+   \param routine  name of the routine, or NULL if there is none yet
+
+   The times in the record are those spent since the previous record.
+ */
+void phasestat_record(const char *phase, const char *routine);
+
+/**
+   \brief Close the statistics file
+ */
+void phasestat_fini(void);
+
+#endif // PHASESTAT_H_
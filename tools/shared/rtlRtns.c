@@ -222,9 +222,13 @@ FtnRteRtn ftnRtlRtns[] = {
     {"merger", "", false, ""},
     {"min", "", false, "k"},
     {"mmul_cmplx16", "", false, ""},
+    {"mmul_cmplx16_team", "", false, ""},
     {"mmul_cmplx8", "", false, ""},
+    {"mmul_cmplx8_team", "", false, ""},
     {"mmul_real4", "", false, ""},
+    {"mmul_real4_team", "", false, ""},
     {"mmul_real8", "", false, ""},
+    {"mmul_real8_team", "", false, ""},
     {"modulov", "", false, ""},
     {"move_alloc", "", true, ""},
     {"mp_bcs_nest", "", false, ""},
@@ -227,9 +227,13 @@ typedef enum {
   RTE_merger,
   RTE_min,
   RTE_mmul_cmplx16,
+  RTE_mmul_cmplx16_team,
   RTE_mmul_cmplx8,
+  RTE_mmul_cmplx8_team,
   RTE_mmul_real4,
+  RTE_mmul_real4_team,
   RTE_mmul_real8,
+  RTE_mmul_real8_team,
   RTE_modulov,
   RTE_move_alloc,
   RTE_mp_bcs_nest,
@@ -8,14 +8,22 @@
 /**
    \file
    \brief compiler storage allocation utility routines.
+
+   Each area is a bump-pointer region built from fixed-size chunks.
+   freearea() does not hand the chunks back to malloc. It splices them
+   onto a free list in constant time, and the next area that needs a
+   chunk takes one from there. Areas that are emptied for every routine
+   therefore stop calling malloc once the compile reaches its
+   high-water mark. An item too large for a chunk gets a block of its
+   own, and freearea() returns that block to malloc.
  */
 
 #include "gbldefs.h"
 #include "global.h"
 #include "error.h"
 
-#define SIZE                                             \
-  2000          /* size in bytes of each block of memory \
+#define SIZE                                              \
+  65536         /* size in bytes of each chunk of memory  \
                  * obtained from malloc (NEW). */
 #define ANUM 30 /* number of different areas supported, 0...ANUM-1 */
 
@@ -25,10 +33,56 @@ typedef char *PTR;
 #define PTRSZ sizeof(PTR)
 #define ALIGN(o) (((o) + (PTRSZ - 1)) & (~(PTRSZ - 1)))
 
-static char *areap[ANUM] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL,
-                            NULL, NULL, NULL, NULL, NULL, NULL, NULL,
-                            NULL, NULL, NULL, NULL, NULL, NULL, NULL};
-static int avail[ANUM];
+typedef struct CHUNK {
+  struct CHUNK *next;
+  size_t size; /* in bytes, including this header */
+} CHUNK;
+
+#define HDRSZ ALIGN(sizeof(CHUNK))
+
+static struct {
+  CHUNK *head;  /* chunk being allocated from; most recent first */
+  CHUNK *tail;  /* oldest chunk, for splicing onto free_chunks */
+  CHUNK *large; /* blocks holding a single oversized item */
+  size_t avail; /* offset of the next free byte in head */
+#if DEBUG
+  size_t nitems;  /* getitem calls since the area was last freed */
+  size_t nbytes;  /* bytes handed out since the area was last freed */
+  size_t held;    /* bytes of chunks and large blocks owned by the area */
+  size_t hiwater; /* largest value of held */
+  int nchunks;    /* chunks owned by the area */
+  int nlarge;     /* large blocks owned by the area */
+  int nfrees;     /* number of freearea calls */
+#endif
+} areas[ANUM];
+
+static CHUNK *free_chunks; /* chunks released by freearea() */
+
+#if DEBUG
+static struct {
+  size_t malloced; /* chunks obtained from malloc */
+  size_t reused;   /* chunks taken from free_chunks */
+  size_t large;    /* oversized blocks obtained from malloc */
+  size_t pooled;   /* chunks currently on free_chunks */
+  size_t held;     /* bytes held by all areas together */
+  size_t hiwater;  /* largest value of held */
+} stats;
+#endif
+
+static CHUNK *
+new_chunk(int area, size_t sz)
+{
+  char *p;
+  CHUNK *c;
+
+  NEW(p, char, sz);
+  if (p == NULL)
+    interr("getitem: no mem avail", area, ERR_Fatal);
+  c = (CHUNK *)p;
+  c->next = NULL;
+  c->size = sz;
+  return c;
+}
 
 /**
    \param area is an area
@@ -38,40 +92,66 @@ char *
 getitem(int area, int size)
 {
   char *p;
+  size_t sz;
+  CHUNK *c;
 
   assert(area >= 0 && area < ANUM, "getitem: bad area", area, ERR_Fatal);
-  size = ALIGN(size); /* round up to multiple of PTRSZ */
-
-  if (areap[area] == NULL) {
-    int sz = SIZE;
-    if (size + PTRSZ > SIZE)
-      sz = size + PTRSZ;
-    NEW(p, char, sz);
-    areap[area] = p;
-    if (p == NULL)
-      interr("getitem: no mem avail", area, ERR_Fatal);
-    *((PTR *)p) = NULL;
-    avail[area] = PTRSZ;
-  } else if (avail[area] + size > SIZE) {
-    int sz = SIZE;
-    if (size + PTRSZ > SIZE)
-      sz = size + PTRSZ;
-    NEW(p, char, sz);
-    if (p == NULL)
-      interr("getitem: no mem avail", area, ERR_Fatal);
-    *((PTR *)p) = areap[area];
-    areap[area] = p;
-    avail[area] = PTRSZ;
+  sz = ALIGN((size_t)size); /* round up to multiple of PTRSZ */
+
+  if (HDRSZ + sz > SIZE) {
+    /* the current chunk is left as it is */
+    c = new_chunk(area, HDRSZ + sz);
+    c->next = areas[area].large;
+    areas[area].large = c;
+    p = (char *)c + HDRSZ;
+#if DEBUG
+    ++stats.large;
+    ++areas[area].nlarge;
+    areas[area].held += c->size;
+    stats.held += c->size;
+#endif
+  } else {
+    if (areas[area].head == NULL || areas[area].avail + sz > SIZE) {
+      if (free_chunks != NULL) {
+        c = free_chunks;
+        free_chunks = c->next;
+#if DEBUG
+        ++stats.reused;
+        --stats.pooled;
+#endif
+      } else {
+        c = new_chunk(area, SIZE);
+#if DEBUG
+        ++stats.malloced;
+#endif
+      }
+      c->next = areas[area].head;
+      if (areas[area].head == NULL)
+        areas[area].tail = c;
+      areas[area].head = c;
+      areas[area].avail = HDRSZ;
+#if DEBUG
+      ++areas[area].nchunks;
+      areas[area].held += SIZE;
+      stats.held += SIZE;
+#endif
+    }
+    p = (char *)areas[area].head + areas[area].avail;
+    areas[area].avail += sz;
   }
-  p = areap[area] + avail[area];
-  avail[area] += size;
 #if DEBUG
+  ++areas[area].nitems;
+  areas[area].nbytes += sz;
+  if (areas[area].held > areas[area].hiwater)
+    areas[area].hiwater = areas[area].held;
+  if (stats.held > stats.hiwater)
+    stats.hiwater = stats.held;
   if (DBGBIT(0, 0x20000)) {
     char *q, cc;
-    int s;
+    size_t s;
     /* fill with junk */
     cc = 0xa6;
-    for (s = size, q = p; s; --s, ++q) {
+    for (s = sz, q = p; s; --s, ++q) {
       *q = cc;
       cc = (cc << 1) | (cc >> 7);
     }
@@ -83,14 +163,34 @@ getitem(int area, int size)
 void
 freearea(int area)
 {
-  char *p, *q;
+  CHUNK *c, *next;
 
   assert(area >= 0 && area < ANUM, "freearea: bad area", area, ERR_Fatal);
-  for (p = areap[area]; p != NULL; p = q) {
-    q = *((PTR *)p); /* get next before free!!! */
+  if (areas[area].head != NULL) {
+#if DEBUG
+    stats.pooled += areas[area].nchunks;
+#endif
+    areas[area].tail->next = free_chunks;
+    free_chunks = areas[area].head;
+    areas[area].head = NULL;
+    areas[area].tail = NULL;
+  }
+  for (c = areas[area].large; c != NULL; c = next) {
+    char *p = (char *)c;
+    next = c->next; /* get next before free!!! */
     FREE(p);
   }
-  areap[area] = NULL;
+  areas[area].large = NULL;
+  areas[area].avail = 0;
+#if DEBUG
+  areas[area].nitems = 0;
+  areas[area].nbytes = 0;
+  stats.held -= areas[area].held;
+  areas[area].held = 0;
+  areas[area].nchunks = 0;
+  areas[area].nlarge = 0;
+  ++areas[area].nfrees;
+#endif
 }
 
 #if DEBUG
@@ -99,20 +199,42 @@ reportarea(int full)
 {
   int area;
   for (area = 0; area < ANUM; ++area) {
-    if (areap[area] == NULL) {
+    if (areas[area].head == NULL && areas[area].large == NULL) {
       if (full)
-        fprintf(gbl.dbgfil, "area[%2d] is empty\n", area);
+        fprintf(gbl.dbgfil, "area[%2d] is empty, high water %lu bytes, "
+                            "freed %d times\n",
+                area, (unsigned long)areas[area].hiwater, areas[area].nfrees);
     } else {
-      char *p, *q;
-      int total = 0;
-      for (p = areap[area]; p != NULL; p = q) {
-        q = *((PTR *)p); /* get next before free!!! */
-        total += SIZE;
-      }
-      fprintf(gbl.dbgfil, "area[%2d] >= %d bytes with %d free\n", area, total,
-              avail[area]);
+      fprintf(gbl.dbgfil,
+              "area[%2d] %lu bytes in %d chunks and %d large blocks, "
+              "%lu items using %lu bytes, %lu free in current chunk, "
+              "high water %lu bytes, freed %d times\n",
+              area, (unsigned long)areas[area].held, areas[area].nchunks,
+              areas[area].nlarge,
+              (unsigned long)areas[area].nitems,
+              (unsigned long)areas[area].nbytes,
+              (unsigned long)(areas[area].head ? SIZE - areas[area].avail : 0),
+              (unsigned long)areas[area].hiwater, areas[area].nfrees);
     }
   }
+  fprintf(gbl.dbgfil,
+          "chunks of %d bytes: %lu from malloc, %lu reused, %lu pooled; "
+          "%lu large blocks\n",
+          SIZE, (unsigned long)stats.malloced, (unsigned long)stats.reused,
+          (unsigned long)stats.pooled, (unsigned long)stats.large);
+  fprintf(gbl.dbgfil, "all areas %lu bytes, high water %lu bytes\n",
+          (unsigned long)stats.held, (unsigned long)stats.hiwater);
+}
+
+/**
+   \brief Return the bytes held by all areas together, and the largest
+   total they have held at any one time.
+ */
+void
+areausage(size_t *held, size_t *hiwater)
+{
+  *held = stats.held;
+  *hiwater = stats.hiwater;
 }
 #endif
 
@@ -99,6 +99,7 @@ sym_init_first(void)
 
   stb.namavl = 1;
   stb.wrdavl = 0;
+  stb.hashsz = HASHSIZE;
   for (i = 0; i <= HASHSIZE; i++)
     stb.hashtb[i] = SPTR_NULL;
 
@@ -80,13 +80,35 @@ extern "C" {
 #endif
 
 /* hashtab stuff */
-#define HASHSIZE 9973
-#define HASH_CON(p) ((p[0] ^ p[1]) % HASHSIZE)
-#define HASH_ID(hv, p, len)                            \
-  hv = p[(len)-1] | (*p << 16) | (p[(len) >> 1] << 8); \
-  if ((int)(len) > 3)                                  \
-    hv ^= (p[1] << 4);                                 \
-  hv %= HASHSIZE;
+#define HASHSIZE 9973 /* initial number of buckets in stb.hashtb */
+
+/* FNV-1a hash of the len characters of a name or character constant */
+static inline unsigned
+hash_name(const char *p, int len)
+{
+  unsigned h = 2166136261u;
+  while (len-- > 0)
+    h = (h ^ (unsigned char)*p++) * 16777619u;
+  return h;
+}
+
+/* Mix the first two words of a constant's value */
+static inline unsigned
+hash_con(unsigned a, unsigned b)
+{
+  unsigned h = a * 0x9e3779b1u ^ b;
+  h ^= h >> 15;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  return h;
+}
+
+/* The bucket index depends on stb.hashsz, which grow_sym_hash() may
+ * change.  A value computed by these macros must not be kept across a
+ * call to grow_sym_hash().
+ */
+#define HASH_CON(p) ((int)(hash_con((p)[0], (p)[1]) % stb.hashsz))
+#define HASH_ID(hv, p, len) hv = (int)(hash_name(p, len) % stb.hashsz);
 #define HASH_STR(hv, p, len)     \
   if (len) {                     \
     /*hv =*/HASH_ID(hv, p, len); \
@@ -274,6 +296,7 @@ typedef struct {
   }dt;
   int curr_scope;
   SPTR hashtb[HASHSIZE + 1];
+  int hashsz; /* always HASHSIZE here */
   SPTR firstusym, firstosym;
   STG_MEMBERS(SYM);
   char *n_base;